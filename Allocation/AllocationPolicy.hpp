@@ -0,0 +1,384 @@
+/**
+ * \file    AllocationPolicy.hpp
+ * \brief   Allocation of large element buffers: hugepages, NUMA binding and
+ *          pre-faulting.
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \details 'MakeRegion()' allocates the element storage of a buffer according
+ *          to an 'AllocationPolicy'. The default policy uses 'new', like the
+ *          buffers always did. Any other policy maps anonymous memory:
+ *          - Pages::Huge maps explicit 2 MB hugepages ('MAP_HUGETLB'), and
+ *            falls back to transparent hugepages when none are reserved,
+ *          - Pages::Transparent aligns the mapping to 2 MB and requests
+ *            transparent hugepages ('madvise(MADV_HUGEPAGE)'),
+ *          - 'node' binds the memory to a NUMA node ('mbind'),
+ *          - 'prefault' touches every page, so the first pass at runtime does
+ *            not page-fault.
+ *          'GrowRegion()' enlarges a mapped region with 'mremap()', keeping
+ *          the contents without copying them.
+ *
+ * \note    Linux only, on other platforms every policy falls back to 'new'.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef ALLOCATION_POLICY_HPP_
+#define ALLOCATION_POLICY_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+
+/******************************************************************************
+ * Types                                                                      *
+ *****************************************************************************/
+/**
+ * \struct  AllocationPolicy
+ * \brief   How to allocate the element storage of a buffer.
+ */
+struct AllocationPolicy
+{
+    enum class Pages : uint8_t
+    {
+        Default,                                                // Pages of the default allocator
+        Transparent,                                            // Transparent hugepages, 2 MB aligned
+        Huge,                                                   // Explicit hugepages, else transparent
+    };
+
+    Pages pages{Pages::Default};
+    int   node{-1};                                             // NUMA node to bind to, -1 for none
+    bool  prefault{false};                                      // Touch every page at allocation
+
+    static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+
+    /**
+     * \brief   Checks if the policy needs a mapping instead of 'new'.
+     * \returns True if anything other than the default is requested.
+     */
+    constexpr bool IsDefault() const
+    {
+        return (pages == Pages::Default) && (node < 0) && !prefault;
+    }
+};
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+/**
+ * \class   RegionDeleter
+ * \brief   Deleter for storage allocated by 'MakeRegion()'.
+ * \details Uses 'delete[]' for storage allocated with 'new', else destroys
+ *          the elements and unmaps the region.
+ */
+template<typename T>
+class RegionDeleter
+{
+public:
+    RegionDeleter() noexcept = default;
+    RegionDeleter(const size_t count, void* mapping, const size_t bytes, const bool huge) noexcept :
+        mCount(count), mMapping(mapping), mBytes(bytes), mHuge(huge)
+    { }
+
+    void operator()(T* elements) const;
+
+    bool IsMapped() const { return (mMapping != nullptr); }
+    bool IsHuge() const { return mHuge; }
+    size_t Bytes() const { return mBytes; }
+    size_t Count() const { return mCount; }
+    void* Mapping() const { return mMapping; }
+
+private:
+    size_t mCount{0};
+    void*  mMapping{nullptr};                                   // Start of the mapping, nullptr if allocated with 'new'
+    size_t mBytes{0};                                           // Size of the mapping
+    bool   mHuge{false};                                        // Explicit hugepages
+};
+
+template<typename T>
+using Region = std::unique_ptr<T[], RegionDeleter<T>>;
+
+
+/**
+ * \brief   Destroys the elements and frees the storage.
+ * \param   elements    The storage returned by 'MakeRegion()'.
+ */
+template<typename T>
+void RegionDeleter<T>::operator()(T* elements) const
+{
+    if (mMapping == nullptr)
+    {
+        delete[] elements;
+        return;
+    }
+
+    for (size_t i = 0; i < mCount; i++)
+    {
+        elements[i].~T();
+    }
+#if defined(__linux__)
+    munmap(mMapping, mBytes);
+#endif // __linux__
+}
+
+
+/******************************************************************************
+ * Functions                                                                  *
+ *****************************************************************************/
+#if defined(__linux__)
+namespace allocation_detail
+{
+    /**
+     * \brief   Rounds 'value' up to a multiple of 'multiple'.
+     */
+    inline size_t RoundUp(const size_t value, const size_t multiple)
+    {
+        return ((value + multiple - 1) / multiple) * multiple;
+    }
+
+    /**
+     * \brief   Maps anonymous memory aligned to 'alignment', trimming the excess.
+     * \returns The aligned mapping of 'bytes', or nullptr on failure.
+     */
+    inline void* MapAligned(const size_t bytes, const size_t alignment)
+    {
+        const size_t total = bytes + alignment;
+        void* mapping = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        const auto start   = reinterpret_cast<uintptr_t>(mapping);
+        const auto aligned = RoundUp(start, alignment);
+        const auto end     = aligned + bytes;
+
+        if (aligned > start)
+        {
+            munmap(mapping, aligned - start);                   // Trim the head
+        }
+        if ((start + total) > end)
+        {
+            munmap(reinterpret_cast<void*>(end), (start + total) - end);    // Trim the tail
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /**
+     * \brief   Binds a mapping to a NUMA node, without depending on libnuma.
+     * \returns True if bound, else false.
+     */
+    inline bool Bind(void* mapping, const size_t bytes, const int node)
+    {
+        constexpr int MpolBind = 2;                             // MPOL_BIND from <numaif.h>
+        constexpr size_t BitsPerWord = 8 * sizeof(unsigned long);
+
+        if (node < 0 || static_cast<size_t>(node) >= (4 * BitsPerWord))
+        {
+            return false;                                       // Node outside the mask
+        }
+
+        unsigned long mask[4] = { 0, 0, 0, 0 };
+        mask[node / BitsPerWord] = 1UL << (node % BitsPerWord);
+
+        return (syscall(SYS_mbind, mapping, bytes, MpolBind, mask, 4 * BitsPerWord + 1, 0) == 0);
+    }
+} // namespace allocation_detail
+#endif // __linux__
+
+/**
+ * \brief   Allocates storage for 'count' default initialized elements.
+ * \param   count   The number of elements.
+ * \param   policy  How to allocate the storage.
+ * \returns The storage, empty if 'count' is 0 or allocation fails. Also empty
+ *          when the NUMA node cannot be bound to.
+ */
+template<typename T>
+Region<T> MakeRegion(const size_t count, const AllocationPolicy& policy = AllocationPolicy{})
+{
+    if (count == 0)
+    {
+        return Region<T>(nullptr);
+    }
+
+#if defined(__linux__)
+    if (!policy.IsDefault())
+    {
+        using namespace allocation_detail;
+
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t hugepage = AllocationPolicy::HugePageSize;
+
+        if (count > (SIZE_MAX - hugepage) / sizeof(T))
+        {
+            return Region<T>(nullptr);                          // Size overflow
+        }
+
+        void*  mapping = nullptr;
+        size_t bytes   = 0;
+        bool   huge    = false;
+
+        if (policy.pages == AllocationPolicy::Pages::Huge)
+        {
+            bytes = RoundUp(count * sizeof(T), hugepage);
+            mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            huge = (mapping != MAP_FAILED);
+            if (!huge)
+            {
+                mapping = nullptr;                              // No hugepages reserved, use transparent ones
+            }
+        }
+
+        if (mapping == nullptr)
+        {
+            const bool transparent = (policy.pages != AllocationPolicy::Pages::Default);
+
+            bytes = RoundUp(count * sizeof(T), transparent ? hugepage : page);
+            mapping = MapAligned(bytes, transparent ? hugepage : page);
+            if (mapping == nullptr)
+            {
+                return Region<T>(nullptr);
+            }
+#if defined(MADV_HUGEPAGE)
+            if (transparent)
+            {
+                madvise(mapping, bytes, MADV_HUGEPAGE);         // Advice only, may be disabled system wide
+            }
+#endif // MADV_HUGEPAGE
+        }
+
+        if ((policy.node >= 0) && !Bind(mapping, bytes, policy.node))
+        {
+            munmap(mapping, bytes);
+            return Region<T>(nullptr);                          // Binding requested, but failed
+        }
+
+        if (policy.prefault)
+        {
+            auto bytes_ptr = static_cast<volatile uint8_t*>(mapping);
+            for (size_t offset = 0; offset < bytes; offset += page)
+            {
+                bytes_ptr[offset] = 0;                          // Fault in, after binding
+            }
+        }
+
+        T* elements = static_cast<T*>(mapping);
+        for (size_t i = 0; i < count; i++)
+        {
+            new (&elements[i]) T;
+        }
+        return Region<T>(elements, RegionDeleter<T>(count, mapping, bytes, huge));
+    }
+#else
+    (void)policy;
+#endif // __linux__
+
+    return Region<T>(new(std::nothrow) T[count]);
+}
+
+/**
+ * \brief   Grows a mapped region to 'count' elements, keeping the contents.
+ * \details The mapping is enlarged with 'mremap()', in place or by moving
+ *          the pages, so the existing elements are not copied. The elements
+ *          added are default initialized, bound to the NUMA node and
+ *          pre-faulted according to 'policy'. Only for trivially copyable
+ *          types, as moving the pages relocates the elements bitwise.
+ * \param   region  The storage returned by 'MakeRegion()'.
+ * \param   count   The new number of elements, not less than the current.
+ * \param   policy  The policy the region was allocated with.
+ * \returns True if grown; false if the region was allocated with 'new', the
+ *          type is not trivially copyable or remapping fails. The region is
+ *          unchanged then.
+ */
+template<typename T>
+bool GrowRegion(Region<T>& region, const size_t count, const AllocationPolicy& policy)
+{
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+    using namespace allocation_detail;
+
+    const auto& deleter = region.get_deleter();
+    if (!std::is_trivially_copyable<T>::value || !deleter.IsMapped() || (region.get() != deleter.Mapping()))
+    {
+        return false;                                           // Cannot relocate by moving pages
+    }
+
+    const size_t current = deleter.Count();
+    if ((count < current) || (count > (SIZE_MAX - AllocationPolicy::HugePageSize) / sizeof(T)))
+    {
+        return false;                                           // Shrinking or size overflow
+    }
+
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const bool   transparent = (policy.pages != AllocationPolicy::Pages::Default);
+    const bool   huge = deleter.IsHuge();
+    const size_t oldBytes = deleter.Bytes();
+    const size_t bytes = RoundUp(count * sizeof(T), transparent ? AllocationPolicy::HugePageSize : page);
+
+    void* mapping = deleter.Mapping();
+    if (bytes > oldBytes)
+    {
+        mapping = mremap(mapping, oldBytes, bytes, MREMAP_MAYMOVE);
+        if (mapping == MAP_FAILED)
+        {
+            return false;                                       // Old mapping remains valid
+        }
+
+        auto added = static_cast<uint8_t*>(mapping) + oldBytes;
+        const size_t addedBytes = bytes - oldBytes;
+#if defined(MADV_HUGEPAGE)
+        if (transparent && !huge)
+        {
+            madvise(added, addedBytes, MADV_HUGEPAGE);
+        }
+#endif // MADV_HUGEPAGE
+        if (policy.node >= 0)
+        {
+            (void)Bind(added, addedBytes, policy.node);         // Best effort, the contents are kept
+        }
+        if (policy.prefault)
+        {
+            auto bytes_ptr = static_cast<volatile uint8_t*>(added);
+            for (size_t offset = 0; offset < addedBytes; offset += page)
+            {
+                bytes_ptr[offset] = 0;
+            }
+        }
+    }
+
+    T* elements = static_cast<T*>(mapping);
+    for (size_t i = current; i < count; i++)
+    {
+        new (&elements[i]) T;
+    }
+
+    region.release();                                           // Pages moved, the old mapping is gone
+    region = Region<T>(elements, RegionDeleter<T>(count, mapping, (bytes > oldBytes) ? bytes : oldBytes, huge));
+    return true;
+#else
+    (void)region;
+    (void)count;
+    (void)policy;
+    return false;
+#endif // __linux__ && MREMAP_MAYMOVE
+}
+
+#endif // ALLOCATION_POLICY_HPP_
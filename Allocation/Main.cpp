@@ -0,0 +1,53 @@
+// Allocates a large buffer with each page policy, reports what was obtained
+// and how long the first pass over the buffer takes.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include "AllocationPolicy.hpp"
+
+static void FirstPass(const char* name, const AllocationPolicy& policy)
+{
+    const size_t count = 256 * 1024 * 1024 / sizeof(uint64_t);     // 256 MB
+
+    auto start = std::chrono::steady_clock::now();
+    auto region = MakeRegion<uint64_t>(count, policy);
+    auto allocated = std::chrono::steady_clock::now();
+
+    if (!region) {
+        std::cout << name << ": allocation failed" << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        region[i] = i;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << name << ": "
+              << (region.get_deleter().IsMapped() ? "mapped" : "new")
+              << (region.get_deleter().IsHuge() ? ", explicit hugepages" : "")
+              << ", allocation " << std::chrono::duration<double, std::milli>(allocated - start).count() << " ms"
+              << ", first pass " << std::chrono::duration<double, std::milli>(end - allocated).count() << " ms"
+              << std::endl;
+}
+
+int main(void)
+{
+    AllocationPolicy policy;
+    FirstPass("Default", policy);
+
+    policy.prefault = true;
+    FirstPass("Default, prefault", policy);
+
+    policy.pages = AllocationPolicy::Pages::Transparent;
+    FirstPass("Transparent, prefault", policy);
+
+    policy.pages = AllocationPolicy::Pages::Huge;
+    FirstPass("Huge, prefault", policy);
+
+    policy.node = 0;
+    FirstPass("Huge, prefault, node 0", policy);
+
+    return 0;
+}
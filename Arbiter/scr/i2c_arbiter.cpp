@@ -14,8 +14,8 @@
  * \note    https://github.com/tlouwers/embedded/tree/master/Arbiter
  *
  * \author  Terry Louwers (terry.louwers@fourtress.nl)
- * \version 1.0
- * \date    09-2018
+ * \version 1.2
+ * \date    10-2026
  */
 
 /************************************************************************/
@@ -23,6 +23,7 @@
 /************************************************************************/
 #include "i2c_arbiter.hpp"
 #include <cassert>
+#include <utility>              // std::move
 
 
 /************************************************************************/
@@ -62,8 +63,6 @@ I2CArbiter::~I2CArbiter()
 {
     mBusy = false;
 
-    mLock.clear(std::memory_order_release);
-
     mBuffer.clear();
 }
 
@@ -95,12 +94,8 @@ void I2CArbiter::Sleep()
 {
     while (mBusy) { __NOP() }                                               // Blocking wait until we can use the bus. Use __ASM instruction to prevent loop from being optimized away.
 
-    irqflags_t irq_state = cpu_irq_save();                                  // Disable global interrupts to prevent race condition
-    while (mLock.test_and_set(std::memory_order_acquire)) { __NOP(); }      // Acquire lock - start of critical section
-
+    irqflags_t irq_state = cpu_irq_save();                                  // Disable global interrupts, clear() does not allow producers
     mBuffer.clear();
-
-    mLock.clear(std::memory_order_release);                                 // Release lock - end of critical section
     cpu_irq_restore(irq_state);                                             // Restore global interrupts
 
     mI2C.Sleep();
@@ -128,31 +123,16 @@ bool I2CArbiter::Write(const HeaderI2C& refHeader, const uint8_t* ptrSrc, size_t
         element.length           = length;
         element.callbackDone     = refCallback;
 
-    // The lock is needed to make a multiple producer of the CircularBuffer
-    //  (which is single producer thread safe only).
-    // The DataRequestHandler is the single consumer, there no lock is
-    //  needed (or allowed! as it is inside an ISR).
+    // The MpscCircularFifo allows multiple producers without a lock.
+    // The owner of the bus is the single consumer, see StartNext().
 
-    irqflags_t irq_state = cpu_irq_save();                                  // Disable global interrupts to prevent race condition
-    while (mLock.test_and_set(std::memory_order_acquire)) { __NOP(); }      // Acquire lock - start of critical section
-
-    bool result = mBuffer.push(element);
+    bool result = mBuffer.push(std::move(element));
     assert(result);
 
-    mLock.clear(std::memory_order_release);                                 // Release lock - end of critical section
-    cpu_irq_restore(irq_state);                                             // Restore global interrupts
-
     // Start the transmission, if not busy yet
-    if (mI2C.IsInit())
+    if (result && mI2C.IsInit())
     {
-        if (!mBusy)
-        {
-            mBusy = true;
-
-            // Reroute the data received callback to the arbiter
-            result = mI2C.Write(refHeader, ptrSrc, length, [this]() { this->DataRequestHandler(); });
-            assert(result);
-        }
+        StartNext();
     }
 
     return result;
@@ -180,31 +160,16 @@ bool I2CArbiter::Read(const HeaderI2C& refHeader, uint8_t* ptrDest, size_t lengt
         element.length           = length;
         element.callbackDone     = refCallback;
 
-    // The lock is needed to make a multiple producer of the CircularBuffer
-    //  (which is single producer thread safe only).
-    // The DataRequestHandler is the single consumer, there no lock is
-    //  needed (or allowed! as it is inside an ISR).
-
-    irqflags_t irq_state = cpu_irq_save();                                  // Disable global interrupts to prevent race condition
-    while (mLock.test_and_set(std::memory_order_acquire)) { __NOP(); }      // Acquire lock - start of critical section
+    // The MpscCircularFifo allows multiple producers without a lock.
+    // The owner of the bus is the single consumer, see StartNext().
 
-    bool result = mBuffer.push(element);
+    bool result = mBuffer.push(std::move(element));
     assert(result);
 
-    mLock.clear(std::memory_order_release);                                 // Release lock - end of critical section
-    cpu_irq_restore(irq_state);                                             // Restore global interrupts
-
     // Start the transmission, if not busy yet
-    if (mI2C.IsInit())
+    if (result && mI2C.IsInit())
     {
-        if (!mBusy)
-        {
-            mBusy = true;
-
-            // Reroute the data received callback to the arbiter
-            result = mI2C.Read(refHeader, ptrDest, length, [this]() { this->DataRequestHandler(); });
-            assert(result);
-        }
+        StartNext();
     }
 
     return result;
@@ -228,12 +193,13 @@ bool I2CArbiter::WriteBlocking(const HeaderI2C& refHeader, const uint8_t* ptrSrc
 
     if (mI2C.IsInit())
     {
-        while (mBusy) { __NOP(); }
+        while (mBusy.exchange(true)) { __NOP(); }
 
-        mBusy = true;
         result = mI2C.WriteBlocking(refHeader, ptrSrc, length);
         assert(result);
         mBusy = false;
+
+        StartNext();                                                        // Requests queued in the meantime
     }
 
     return result;
@@ -257,12 +223,13 @@ bool I2CArbiter::ReadBlocking(const HeaderI2C& refHeader, uint8_t* ptrDest, size
 
     if (mI2C.IsInit())
     {
-        while (mBusy) { __NOP(); }
+        while (mBusy.exchange(true)) { __NOP(); }
 
-        mBusy = true;
         result = mI2C.ReadBlocking(refHeader, ptrDest, length);
         assert(result);
         mBusy = false;
+
+        StartNext();                                                        // Requests queued in the meantime
     }
 
     return result;
@@ -272,6 +239,47 @@ bool I2CArbiter::ReadBlocking(const HeaderI2C& refHeader, uint8_t* ptrDest, size
 /************************************************************************/
 /* Private Members                                                      */
 /************************************************************************/
+/**
+ * \brief   Start the transfer of the request at the head of the queue, if
+ *          the bus is not busy yet.
+ * \details The caller which sets the busy flag owns the bus and is the single
+ *          consumer of the queue. When the head is claimed by a producer but
+ *          not yet published the bus is released again, that producer starts
+ *          the transfer after publishing. The queue is checked again after
+ *          releasing, so a request published in the meantime is not missed.
+ */
+void I2CArbiter::StartNext()
+{
+    while (!mBuffer.empty() && !mBusy.exchange(true))
+    {
+        // Use the element in place, it remains queued until the transfer is done.
+        const ArbiterElementI2C* element = mBuffer.front();
+
+        if (element != nullptr)
+        {
+            bool result = false;
+
+            if (element->is_write_request)
+            {
+                // Reroute the data to send callback to the arbiter
+                result = mI2C.Write(element->header, element->ptrData, element->length, [this]() { this->DataRequestHandler(); });
+                assert(result);
+            }
+            else
+            {
+                // Reroute the data received callback to the arbiter
+                result = mI2C.Read(element->header, element->ptrData, element->length, [this]() { this->DataRequestHandler(); });
+                assert(result);
+            }
+
+            (void)(result);     // Hide compiler warning: unused variable
+            return;
+        }
+
+        mBusy = false;          // Head not published yet, or already handled
+    }
+}
+
 /**
  * \brief   Handler which is called when either TX or RX is done
  *          for I2C, allowing arbitration on the bus.
@@ -280,42 +288,22 @@ bool I2CArbiter::ReadBlocking(const HeaderI2C& refHeader, uint8_t* ptrDest, size
  */
 void I2CArbiter::DataRequestHandler()
 {
-    ArbiterElementI2C element;
-
-    // Since we are the only consumer, using the CircularBuffer class
-    // provides thread safety.
+    // The bus is busy until the transfer is done, making us the only
+    // consumer of the MpscCircularFifo.
+    ArbiterElementI2C* element = mBuffer.front();
+    assert(element != nullptr);
 
-    // Remove the element from the queue, handled.
-    mBuffer.pop(element);
+    // Take the callback, then remove the element from the queue, handled.
+    std::function<void()> callbackDone = std::move(element->callbackDone);
+    mBuffer.pop();
 
     // Call the callback, if there was one set.
-    if (element.callbackDone)
-    {
-        element.callbackDone();
-    }
-
-    bool result = false;
-
-    // Check if we need to handle the next item.
-    if (mBuffer.peek(element))
+    if (callbackDone)
     {
-        if (element.is_write_request)
-        {
-            // Reroute the data to send callback to the arbiter
-            result = mI2C.Write(element.header, element.ptrData, element.length, [this]() { this->DataRequestHandler(); });
-            assert(result);
-        }
-        else
-        {
-            // Reroute the data received callback to the arbiter
-            result = mI2C.Read(element.header, element.ptrData, element.length, [this]() { this->DataRequestHandler(); });
-            assert(result);
-        }
-    }
-    else
-    {
-        mBusy = false;
+        callbackDone();
     }
 
-    (void)(result);     // Hide compiler warning: unused variable
+    // Release the bus, then handle the next item, if any.
+    mBusy = false;
+    StartNext();
 }
@@ -14,8 +14,8 @@
  * \note    https://github.com/tlouwers/embedded/tree/master/Arbiter
  *
  * \author  Terry Louwers (terry.louwers@fourtress.nl)
- * \version 1.0
- * \date    09-2018
+ * \version 1.1
+ * \date    10-2026
  */
 
 #ifndef I2C_ARBITER_HPP_
@@ -28,7 +28,7 @@
 #include <cstdint>              // uint8_t
 #include <atomic>
 #include <functional>
-#include "../../CircularFifo/CircularFifo.hpp"
+#include "../../CircularFifo/MpscCircularFifo.hpp"
 #include "i2c_drv_stub.hpp"
 
 
@@ -39,7 +39,7 @@
  * \def     I2C_ARBITER_BUFFER_SIZE
  * \brief   Size of the I2C Arbiter buffer.
  */
-#define I2C_ARBITER_BUFFER_SIZE       10        // Tweak to get better results, usually 4
+#define I2C_ARBITER_BUFFER_SIZE       16        // Tweak to get better results, must be a power of two
 
 
 /************************************************************************/
@@ -81,12 +81,12 @@ public:
     bool ReadBlocking(const HeaderI2C& refHeader, uint8_t* ptrDest, size_t length);
 
 private:
-    CircularFifo<ArbiterElementI2C, I2C_ARBITER_BUFFER_SIZE> mBuffer;
+    MpscCircularFifo<ArbiterElementI2C, I2C_ARBITER_BUFFER_SIZE> mBuffer;
 
     I2C                mI2C;
     std::atomic<bool>  mBusy;
-    std::atomic_flag   mLock = ATOMIC_FLAG_INIT;
 
+    void StartNext();
     void DataRequestHandler();
 };
 
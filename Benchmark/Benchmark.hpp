@@ -0,0 +1,233 @@
+/**
+ * \file    Benchmark.hpp
+ * \brief   Helpers for the queue benchmark: timestamps, thread pinning,
+ *          latency percentiles and report output.
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \details Every element carries the time it was pushed, the consumer takes
+ *          the time it was popped. Both use steady_clock, which is shared by
+ *          all cores, so the difference is the one-way latency.
+ *
+ * \note    https://github.com/tlouwers/embedded/tree/master/Benchmark
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.0
+ * \date    10-2026
+ */
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+/******************************************************************************
+ * Types                                                                      *
+ *****************************************************************************/
+/**
+ * \struct  Payload
+ * \brief   Element of 'Bytes' bytes, starting with the push timestamp.
+ */
+template<size_t Bytes>
+struct Payload
+{
+    static_assert(Bytes > sizeof(uint64_t), "A payload holds at least the timestamp");
+
+    uint64_t stamp;
+    uint8_t  data[Bytes - sizeof(uint64_t)];
+};
+
+template<>
+struct Payload<sizeof(uint64_t)>
+{
+    uint64_t stamp;
+};
+
+/**
+ * \struct  Result
+ * \brief   Outcome of a single benchmark run.
+ */
+struct Result
+{
+    std::string queue;
+    size_t   elementBytes;
+    size_t   batch;
+    size_t   capacity;
+    size_t   messages;
+    double   seconds;
+    double   opsPerSecond;
+    double   bytesPerSecond;
+    uint64_t p50;                       // One-way latency in ns
+    uint64_t p99;
+    uint64_t p999;
+};
+
+/**
+ * \enum    Format
+ * \brief   Report formats.
+ */
+enum class Format
+{
+    Table,
+    Csv,
+    Json
+};
+
+
+/******************************************************************************
+ * Functions                                                                  *
+ *****************************************************************************/
+/**
+ * \brief   Current time for the timestamps.
+ * \returns Nanoseconds since an arbitrary, system wide epoch.
+ */
+inline uint64_t Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * \brief   Pins the calling thread to a core.
+ * \param   core    The core to run on, negative to leave the thread unpinned.
+ * \returns True if pinned (or left unpinned on request), false otherwise.
+ */
+inline bool PinThread(const int core)
+{
+    if (core < 0)
+    {
+        return true;
+    }
+
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;                       // Not supported on this platform
+#endif
+}
+
+/**
+ * \brief   Waits for the other side after a failed push or pop.
+ * \details Spins a while before yielding, so a consumer on its own core
+ *          reacts quickly while producer and consumer on a single core
+ *          still make progress.
+ * \param   failures    The number of consecutive failures, updated.
+ */
+inline void Backoff(uint32_t& failures)
+{
+    if (++failures > 64)
+    {
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * \brief   Calculates a percentile of the measured latencies.
+ * \param   sorted      The latencies, in ascending order.
+ * \param   percentile  The percentile, 0.0 .. 100.0.
+ * \returns The latency at the percentile, 0 if there are none.
+ */
+inline uint64_t Percentile(const std::vector<uint64_t>& sorted, const double percentile)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+
+    const size_t index = static_cast<size_t>((percentile / 100.0) * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+/**
+ * \brief   Fills in the throughput and latency percentiles of a run.
+ * \param   result      The run, with 'messages', 'elementBytes' and 'seconds' set.
+ * \param   latencies   The latency per message, sorted in place.
+ */
+inline void Summarize(Result& result, std::vector<uint64_t>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+
+    result.opsPerSecond   = static_cast<double>(result.messages) / result.seconds;
+    result.bytesPerSecond = result.opsPerSecond * static_cast<double>(result.elementBytes);
+    result.p50            = Percentile(latencies, 50.0);
+    result.p99            = Percentile(latencies, 99.0);
+    result.p999           = Percentile(latencies, 99.9);
+}
+
+/**
+ * \brief   Writes the results in the requested format.
+ * \param   out         The stream to write to.
+ * \param   results     The results of all runs.
+ * \param   format      Table (human readable), CSV or JSON.
+ */
+inline void Report(std::ostream& out, const std::vector<Result>& results, const Format format)
+{
+    switch (format)
+    {
+        case Format::Csv:
+            out << "queue,element_bytes,batch,capacity,messages,seconds,ops_per_s,bytes_per_s,p50_ns,p99_ns,p999_ns\n";
+            for (const auto& r : results)
+            {
+                out << r.queue << ',' << r.elementBytes << ',' << r.batch << ',' << r.capacity << ','
+                    << r.messages << ',' << r.seconds << ',' << static_cast<uint64_t>(r.opsPerSecond) << ','
+                    << static_cast<uint64_t>(r.bytesPerSecond) << ',' << r.p50 << ',' << r.p99 << ',' << r.p999 << '\n';
+            }
+            break;
+
+        case Format::Json:
+            out << "[\n";
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                const auto& r = results[i];
+                out << "  {\"queue\": \"" << r.queue << "\", \"element_bytes\": " << r.elementBytes
+                    << ", \"batch\": " << r.batch << ", \"capacity\": " << r.capacity
+                    << ", \"messages\": " << r.messages << ", \"seconds\": " << r.seconds
+                    << ", \"ops_per_s\": " << static_cast<uint64_t>(r.opsPerSecond)
+                    << ", \"bytes_per_s\": " << static_cast<uint64_t>(r.bytesPerSecond)
+                    << ", \"p50_ns\": " << r.p50 << ", \"p99_ns\": " << r.p99 << ", \"p999_ns\": " << r.p999
+                    << "}" << ((i + 1 < results.size()) ? "," : "") << '\n';
+            }
+            out << "]\n";
+            break;
+
+        case Format::Table:
+        default:
+            out << "queue                 bytes  batch  capacity        ops/s       MB/s   p50 ns   p99 ns  p999 ns\n";
+            for (const auto& r : results)
+            {
+                char line[160];
+                snprintf(line, sizeof(line), "%-20s %6zu %6zu %9zu %12.0f %10.1f %8llu %8llu %8llu\n",
+                         r.queue.c_str(), r.elementBytes, r.batch, r.capacity, r.opsPerSecond,
+                         r.bytesPerSecond / 1e6, static_cast<unsigned long long>(r.p50),
+                         static_cast<unsigned long long>(r.p99), static_cast<unsigned long long>(r.p999));
+                out << line;
+            }
+            break;
+    }
+}
+
+#endif  // BENCHMARK_HPP_
@@ -0,0 +1,291 @@
+// Compares CircularFifo, Ringbuffer and ContiguousRingbuffer side by side.
+// A producer and a consumer thread, each pinned to a core, move timestamped
+// elements through the queue for every combination of element size, batch
+// size and capacity. Reports ops/s, bytes/s and the p50/p99/p999 one-way
+// latency as a table, CSV or JSON.
+//
+// Usage: BenchmarkMain [--producer-core N] [--consumer-core N]
+//                      [--messages N] [--format table|csv|json]
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "CircularFifo.hpp"
+#include "ContiguousRingbuffer.hpp"
+#include "Ringbuffer.hpp"
+
+struct Options
+{
+    int    producerCore = 0;
+    int    consumerCore = 1;
+    size_t messages     = 1000000;
+    Format format       = Format::Table;
+};
+
+static constexpr size_t Batches[]    = { 1, 16, 64 };       // Elements per push and pop
+static constexpr size_t Capacities[] = { 256, 4096 };       // Elements
+static constexpr size_t MaxBatch     = 64;
+
+// Runs a producer and consumer to completion and summarizes the latencies.
+template<typename Produce, typename Consume>
+static Result Run(const char* queue, const size_t bytes, const size_t batch, const size_t capacity,
+                  const Options& options, Produce produce, Consume consume)
+{
+    std::vector<uint64_t> latencies(options.messages);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        if (!PinThread(options.producerCore))
+        {
+            std::cerr << "Could not pin the producer to core " << options.producerCore << std::endl;
+        }
+        produce();
+    });
+    consume(latencies.data());
+    producer.join();
+
+    const auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.queue        = queue;
+    result.elementBytes = bytes;
+    result.batch        = batch;
+    result.capacity     = capacity;
+    result.messages     = options.messages;
+    result.seconds      = std::chrono::duration<double>(end - start).count();
+    Summarize(result, latencies);
+    return result;
+}
+
+template<size_t Bytes, size_t Capacity>
+static Result RunCircularFifo(const size_t batch, const Options& options)
+{
+    using Item = Payload<Bytes>;
+    static CircularFifo<Item, Capacity> fifo;
+    fifo.clear();
+
+    return Run("CircularFifo", Bytes, batch, Capacity, options,
+        [&]() {
+            Item items[MaxBatch] = {};
+            for (size_t sent = 0; sent < options.messages; )
+            {
+                const size_t count = std::min(batch, options.messages - sent);
+                uint32_t failures = 0;
+                for (size_t done = 0; done < count; )
+                {
+                    const uint64_t now = Now();
+                    for (size_t i = done; i < count; i++) { items[i].stamp = now; }
+
+                    const size_t pushed = (batch == 1) ? (fifo.push(items[0]) ? 1 : 0) :
+                                                         fifo.push_n(&items[done], count - done);
+                    if (pushed == 0) { Backoff(failures); } else { failures = 0; }
+                    done += pushed;
+                }
+                sent += count;
+            }
+        },
+        [&](uint64_t* latencies) {
+            Item items[MaxBatch];
+            uint32_t failures = 0;
+            for (size_t received = 0; received < options.messages; )
+            {
+                const size_t count = std::min(batch, options.messages - received);
+                const size_t popped = (batch == 1) ? (fifo.pop(items[0]) ? 1 : 0) : fifo.pop_n(items, count);
+                if (popped == 0) { Backoff(failures); continue; }
+
+                failures = 0;
+                const uint64_t now = Now();
+                for (size_t i = 0; i < popped; i++) { latencies[received + i] = now - items[i].stamp; }
+                received += popped;
+            }
+        });
+}
+
+template<size_t Bytes>
+static Result RunCircularFifo(const size_t batch, const size_t capacity, const Options& options)
+{
+    static_assert(sizeof(Capacities) / sizeof(Capacities[0]) == 2, "Add the capacity to the dispatch below");
+    return (capacity == Capacities[0]) ? RunCircularFifo<Bytes, Capacities[0]>(batch, options) :
+                                         RunCircularFifo<Bytes, Capacities[1]>(batch, options);
+}
+
+template<size_t Bytes>
+static Result RunRingbuffer(const size_t batch, const size_t capacity, const Options& options)
+{
+    using Item = Payload<Bytes>;
+    Ringbuffer<Item> ringBuff;
+    ringBuff.Resize(capacity);
+
+    return Run("Ringbuffer", Bytes, batch, capacity, options,
+        [&]() {
+            Item items[MaxBatch] = {};
+            for (size_t sent = 0; sent < options.messages; )
+            {
+                const size_t count = std::min(batch, options.messages - sent);
+                uint32_t failures = 0;
+                for (size_t done = 0; done < count; )
+                {
+                    const uint64_t now = Now();
+                    for (size_t i = done; i < count; i++) { items[i].stamp = now; }
+
+                    const size_t pushed = (batch == 1) ? (ringBuff.TryPush(&items[0]) ? 1 : 0) :
+                                                         ringBuff.TryPushUpTo(&items[done], count - done);
+                    if (pushed == 0) { Backoff(failures); } else { failures = 0; }
+                    done += pushed;
+                }
+                sent += count;
+            }
+        },
+        [&](uint64_t* latencies) {
+            Item items[MaxBatch];
+            uint32_t failures = 0;
+            for (size_t received = 0; received < options.messages; )
+            {
+                const size_t count = std::min(batch, options.messages - received);
+                Item* dest = &items[0];
+                const size_t popped = (batch == 1) ? (ringBuff.TryPop(items[0]) ? 1 : 0) : ringBuff.TryPopUpTo(dest, count);
+                if (popped == 0) { Backoff(failures); continue; }
+
+                failures = 0;
+                const uint64_t now = Now();
+                for (size_t i = 0; i < popped; i++) { latencies[received + i] = now - items[i].stamp; }
+                received += popped;
+            }
+        });
+}
+
+template<size_t Bytes>
+static Result RunContiguousRingbuffer(const size_t batch, const size_t capacity, const Options& options)
+{
+    using Item = Payload<Bytes>;
+    ContiguousRingbuffer<Item> ringBuff;
+    ringBuff.Resize(capacity);
+
+    // Zero-copy: the producer fills the elements in place, the consumer reads them in place.
+    return Run("ContiguousRingbuffer", Bytes, batch, capacity, options,
+        [&]() {
+            const Item source = {};
+            for (size_t sent = 0; sent < options.messages; )
+            {
+                const size_t count = std::min(batch, options.messages - sent);
+                uint32_t failures = 0;
+
+                Item* data = nullptr;
+                size_t size = count;
+                while (!ringBuff.Poke(data, size))
+                {
+                    Backoff(failures);
+                    size = count;
+                }
+
+                const uint64_t now = Now();
+                for (size_t i = 0; i < count; i++)
+                {
+                    data[i] = source;
+                    data[i].stamp = now;
+                }
+                ringBuff.Write(count);
+                sent += count;
+            }
+        },
+        [&](uint64_t* latencies) {
+            uint32_t failures = 0;
+            for (size_t received = 0; received < options.messages; )
+            {
+                Item* data = nullptr;
+                size_t size = 1;                                    // Largest available block
+                if (!ringBuff.Peek(data, size)) { Backoff(failures); continue; }
+
+                failures = 0;
+                const size_t count = std::min(std::min(size, batch), options.messages - received);
+                const uint64_t now = Now();
+                for (size_t i = 0; i < count; i++) { latencies[received + i] = now - data[i].stamp; }
+                ringBuff.Read(count);
+                received += count;
+            }
+        });
+}
+
+template<size_t Bytes>
+static void Sweep(const Options& options, std::vector<Result>& results)
+{
+    for (const size_t batch : Batches)
+    {
+        for (const size_t capacity : Capacities)
+        {
+            results.push_back(RunCircularFifo<Bytes>(batch, capacity, options));
+            results.push_back(RunRingbuffer<Bytes>(batch, capacity, options));
+            results.push_back(RunContiguousRingbuffer<Bytes>(batch, capacity, options));
+        }
+    }
+}
+
+static bool Parse(int argc, char* argv[], Options& options)
+{
+    if (std::thread::hardware_concurrency() < 2)
+    {
+        options.producerCore = -1;                                  // Single core: leave both unpinned
+        options.consumerCore = -1;
+    }
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+
+        if (std::strcmp(argv[i], "--producer-core") == 0 && hasValue)
+        {
+            options.producerCore = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--consumer-core") == 0 && hasValue)
+        {
+            options.consumerCore = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--messages") == 0 && hasValue)
+        {
+            options.messages = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--format") == 0 && hasValue)
+        {
+            const char* format = argv[++i];
+            if      (std::strcmp(format, "table") == 0) { options.format = Format::Table; }
+            else if (std::strcmp(format, "csv") == 0)   { options.format = Format::Csv; }
+            else if (std::strcmp(format, "json") == 0)  { options.format = Format::Json; }
+            else { return false; }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return options.messages > 0;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!Parse(argc, argv, options))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--producer-core N] [--consumer-core N]"
+                  << " [--messages N] [--format table|csv|json]" << std::endl;
+        return 1;
+    }
+
+    if (!PinThread(options.consumerCore))
+    {
+        std::cerr << "Could not pin the consumer to core " << options.consumerCore << std::endl;
+    }
+
+    std::vector<Result> results;                                    // Element sizes: 8, 64 and 512 bytes
+    Sweep<8>(options, results);
+    Sweep<64>(options, results);
+    Sweep<512>(options, results);
+
+    Report(std::cout, results, options.format);
+    return 0;
+}
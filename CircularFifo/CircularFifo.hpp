@@ -18,11 +18,23 @@
  *
  * \brief   Single-Producer, Single-Consumer, lock-free, wait-free, circular buffer.
  *
+ * \details The indices use the narrowest lock-free atomic type which can
+ *          hold 'Size'. When 'Size' is a power of two the indices are free
+ *          running and wrapped with a mask, no additional element is needed
+ *          to distinguish between a full and an empty buffer. Otherwise one
+ *          additional element is used and the indices wrap with a modulo.
+ *
+ *          Elements are constructed when pushed and destroyed when popped,
+ *          'emplace()' constructs in place and 'pop()' moves out. 'push_n()'
+ *          and 'pop_n()' transfer a batch with a single index update.
+ *          'front()' and 'pop()' let the consumer use the head element in
+ *          place, without copying it.
+ *
  * \note    https://github.com/tlouwers/embedded/tree/master/CircularFifo
  *
  * \author  Terry Louwers (terry.louwers@fourtress.nl)
- * \version 1.1
- * \date    03-2025
+ * \version 1.4
+ * \date    10-2026
  */
 
 #ifndef CIRCULARFIFO_HPP_
@@ -33,6 +45,38 @@
  *****************************************************************************/
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CIRCULARFIFO_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the tail, head and
+ *          storage. Define as 1 for targets without a data cache to save RAM.
+ */
+#ifndef CIRCULARFIFO_CACHE_LINE_SIZE
+#define CIRCULARFIFO_CACHE_LINE_SIZE    64
+#endif // CIRCULARFIFO_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Type selection                                                             *
+ *****************************************************************************/
+/**
+ * \brief   Narrowest unsigned type which holds 'Size' and is always lock-free
+ *          as atomic, falls back to size_t.
+ */
+template<size_t Size>
+using CircularFifoIndex =
+    typename std::conditional<(Size <= UINT8_MAX)  && (ATOMIC_CHAR_LOCK_FREE  == 2), uint8_t,
+    typename std::conditional<(Size <= UINT16_MAX) && (ATOMIC_SHORT_LOCK_FREE == 2), uint16_t,
+    typename std::conditional<(Size <= UINT32_MAX) && (ATOMIC_INT_LOCK_FREE   == 2), uint32_t,
+    size_t>::type>::type>::type;
 
 
 /******************************************************************************
@@ -41,14 +85,30 @@
 template<typename Element, size_t Size>
 class CircularFifo
 {
+    static_assert(Size > 0, "CircularFifo requires a size of at least 1");
+
 public:
-    static constexpr size_t Capacity = Size + 1;
+    static constexpr bool   PowerOfTwo = ((Size & (Size - 1)) == 0);
+    static constexpr size_t Capacity   = PowerOfTwo ? Size : Size + 1;     // Number of slots in storage
 
     CircularFifo() : _tail(0), _head(0) {}
+    ~CircularFifo();
+
+    CircularFifo(const CircularFifo&) = delete;
+    CircularFifo& operator=(const CircularFifo&) = delete;
 
     bool push(const Element& item);
+    bool push(Element&& item);
+    template<typename... Args>
+    bool emplace(Args&&... args);
     bool pop(Element& item);
+    bool pop();
     bool peek(Element& item) const;
+    Element* front();
+    const Element* front() const;
+
+    size_t push_n(const Element* items, size_t count);
+    size_t pop_n(Element* items, size_t count);
 
     bool empty() const;
     bool full() const;
@@ -56,38 +116,89 @@ public:
     void clear();
 
 private:
-    inline size_t increment(size_t idx) const;
+    using Index = CircularFifoIndex<Size>;
+
+    static constexpr size_t IndexAlignment   = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(std::atomic<Index>)) ?
+                                                CIRCULARFIFO_CACHE_LINE_SIZE : alignof(std::atomic<Index>);
+    static constexpr size_t ElementAlignment = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(Element)) ?
+                                                CIRCULARFIFO_CACHE_LINE_SIZE : alignof(Element);
+
+    using Storage = typename std::aligned_storage<sizeof(Element), alignof(Element)>::type;
+
+    static inline Index increment(Index idx);
+    static inline Index advance(Index idx, size_t count);
+    static inline size_t slot(Index idx);
+    static inline size_t used(Index tail, Index head);
+    static inline bool isFull(Index tail, Index head);
+
+    inline Element* element(Index idx);
+    inline const Element* element(Index idx) const;
+    void destroy(Index head, Index tail);
 
-    std::atomic<size_t>   _tail;            // Tail (input) index
-    Element               _array[Capacity]; // Circular buffer storage
-    std::atomic<size_t>   _head;            // Head (output) index
+    alignas(IndexAlignment)   std::atomic<Index> _tail;         // Tail (input) index, owned by producer
+    alignas(IndexAlignment)   std::atomic<Index> _head;         // Head (output) index, owned by consumer
+    alignas(ElementAlignment) Storage _array[Capacity];         // Circular buffer storage, raw
 };
 
+/**
+ * \brief   Destructor, destroys the elements still in the buffer.
+ */
+template<typename Element, size_t Size>
+CircularFifo<Element, Size>::~CircularFifo()
+{
+    destroy(_head.load(std::memory_order_relaxed), _tail.load(std::memory_order_relaxed));
+}
+
 /**
  * \brief   Adds an item to the buffer.
- * \param   item    The element to add.
+ * \param   item    The element to add, copied into the buffer.
  * \return  True if the item was added successfully; false if the buffer is full.
  * \note    This method is thread-safe and can be called by a single producer.
  */
 template<typename Element, size_t Size>
 bool CircularFifo<Element, Size>::push(const Element& item)
+{
+    return emplace(item);
+}
+
+/**
+ * \brief   Adds an item to the buffer.
+ * \param   item    The element to add, moved into the buffer.
+ * \return  True if the item was added successfully; false if the buffer is full,
+ *          the item is left untouched then.
+ * \note    This method is thread-safe and can be called by a single producer.
+ */
+template<typename Element, size_t Size>
+bool CircularFifo<Element, Size>::push(Element&& item)
+{
+    return emplace(std::move(item));
+}
+
+/**
+ * \brief   Constructs an item in place at the tail of the buffer.
+ * \param   args    The arguments passed to the constructor of the element.
+ * \return  True if the item was added successfully; false if the buffer is full.
+ * \note    This method is thread-safe and can be called by a single producer.
+ */
+template<typename Element, size_t Size>
+template<typename... Args>
+bool CircularFifo<Element, Size>::emplace(Args&&... args)
 {
     const auto current_tail = _tail.load(std::memory_order_relaxed);
-    const auto next_tail = increment(current_tail);
 
-    if (next_tail == _head.load(std::memory_order_acquire))
+    if (isFull(current_tail, _head.load(std::memory_order_acquire)))
     {
         return false; // Buffer is full
     }
 
-    _array[current_tail] = item;
-    _tail.store(next_tail, std::memory_order_release);
+    new (&_array[slot(current_tail)]) Element(std::forward<Args>(args)...);
+    _tail.store(increment(current_tail), std::memory_order_release);
     return true;
 }
 
 /**
  * \brief   Removes an item from the buffer.
- * \param   item    Reference to store the removed element.
+ * \param   item    Reference to store the removed element, moved out of the buffer.
  * \return  True if an item was removed successfully; false if the buffer is empty.
  * \note    This method is thread-safe and can be called by a single consumer.
  */
@@ -101,7 +212,9 @@ bool CircularFifo<Element, Size>::pop(Element& item)
         return false; // Buffer is empty
     }
 
-    item = _array[current_head];
+    Element* current = element(current_head);
+    item = std::move(*current);
+    current->~Element();
     _head.store(increment(current_head), std::memory_order_release);
     return true;
 }
@@ -122,10 +235,124 @@ bool CircularFifo<Element, Size>::peek(Element& item) const
         return false; // Buffer is empty
     }
 
-    item = _array[current_head];
+    item = *element(current_head);
+    return true;
+}
+
+/**
+ * \brief   Removes the item at the head of the buffer, without moving it out.
+ * \return  True if an item was removed successfully; false if the buffer is empty.
+ * \note    This method is thread-safe and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+bool CircularFifo<Element, Size>::pop()
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+
+    if (current_head == _tail.load(std::memory_order_acquire))
+    {
+        return false; // Buffer is empty
+    }
+
+    element(current_head)->~Element();
+    _head.store(increment(current_head), std::memory_order_release);
     return true;
 }
 
+/**
+ * \brief   Gets the item at the head of the buffer, to use it in place.
+ * \return  Pointer to the head element; nullptr if the buffer is empty.
+ *          The element remains valid until it is removed with 'pop()'.
+ * \note    This method is thread-safe and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+Element* CircularFifo<Element, Size>::front()
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+
+    if (current_head == _tail.load(std::memory_order_acquire))
+    {
+        return nullptr; // Buffer is empty
+    }
+
+    return element(current_head);
+}
+
+/**
+ * \brief   Gets the item at the head of the buffer, to use it in place.
+ * \return  Pointer to the head element; nullptr if the buffer is empty.
+ *          The element remains valid until it is removed with 'pop()'.
+ * \note    This method is thread-safe and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+const Element* CircularFifo<Element, Size>::front() const
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+
+    if (current_head == _tail.load(std::memory_order_acquire))
+    {
+        return nullptr; // Buffer is empty
+    }
+
+    return element(current_head);
+}
+
+/**
+ * \brief   Adds up to 'count' items to the buffer, published at once.
+ * \param   items   The elements to add, copied into the buffer.
+ * \param   count   The number of elements to add.
+ * \return  The number of items added, 0 if the buffer is full.
+ * \note    This method is thread-safe and can be called by a single producer.
+ */
+template<typename Element, size_t Size>
+size_t CircularFifo<Element, Size>::push_n(const Element* items, size_t count)
+{
+    const auto current_tail = _tail.load(std::memory_order_relaxed);
+    const size_t available = Size - used(current_tail, _head.load(std::memory_order_acquire));
+
+    if (count > available)
+    {
+        count = available;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        new (&_array[slot(advance(current_tail, i))]) Element(items[i]);
+    }
+
+    _tail.store(advance(current_tail, count), std::memory_order_release);
+    return count;
+}
+
+/**
+ * \brief   Removes up to 'count' items from the buffer, released at once.
+ * \param   items   The destination for the removed elements, moved out of the buffer.
+ * \param   count   The maximum number of elements to remove.
+ * \return  The number of items removed, 0 if the buffer is empty.
+ * \note    This method is thread-safe and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+size_t CircularFifo<Element, Size>::pop_n(Element* items, size_t count)
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    const size_t available = used(_tail.load(std::memory_order_acquire), current_head);
+
+    if (count > available)
+    {
+        count = available;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Element* current = element(advance(current_head, i));
+        items[i] = std::move(*current);
+        current->~Element();
+    }
+
+    _head.store(advance(current_head, count), std::memory_order_release);
+    return count;
+}
+
 /**
  * \brief   Checks if the buffer is empty.
  * \remark  This is a snapshot; the queue status may change by either producer
@@ -148,10 +375,8 @@ bool CircularFifo<Element, Size>::empty() const
 template<typename Element, size_t Size>
 bool CircularFifo<Element, Size>::full() const
 {
-    const auto next_tail = increment(_tail.load());
-
     // Snapshot with acceptance that this comparison is not atomic
-    return next_tail == _head.load();
+    return isFull(_tail.load(), _head.load());
 }
 
 /**
@@ -165,13 +390,16 @@ bool CircularFifo<Element, Size>::isLockFree() const
 }
 
 /**
- * \brief   Clears the buffer by resetting head and tail to zero.
+ * \brief   Clears the buffer by destroying the elements in it and resetting
+ *          head and tail to zero.
  * \note    This operation is not thread-safe and should be used with caution.
  *          It is recommended to ensure that the buffer is empty before calling this method.
  */
 template<typename Element, size_t Size>
 void CircularFifo<Element, Size>::clear()
 {
+    destroy(_head.load(std::memory_order_acquire), _tail.load(std::memory_order_acquire));
+
     _tail.store(0, std::memory_order_release);
     _head.store(0, std::memory_order_release);
 }
@@ -180,11 +408,97 @@ void CircularFifo<Element, Size>::clear()
  * \brief   Increments the index in a circular manner.
  * \param   idx     The index to increment.
  * \return  The incremented index, wrapped around if it exceeds the capacity.
+ *          Free running indices wrap with the index type, as its range is a
+ *          multiple of the power of two size.
  */
 template<typename Element, size_t Size>
-inline size_t CircularFifo<Element, Size>::increment(size_t idx) const
+inline typename CircularFifo<Element, Size>::Index CircularFifo<Element, Size>::increment(Index idx)
 {
-    return (idx + 1) % Capacity;
+    return PowerOfTwo ? static_cast<Index>(idx + 1) : static_cast<Index>((idx + 1) % Capacity);
+}
+
+/**
+ * \brief   Advances the index in a circular manner.
+ * \param   idx     The index to advance.
+ * \param   count   The number of elements to advance, at most 'Size'.
+ * \return  The advanced index, wrapped around if it exceeds the capacity.
+ */
+template<typename Element, size_t Size>
+inline typename CircularFifo<Element, Size>::Index CircularFifo<Element, Size>::advance(Index idx, size_t count)
+{
+    return PowerOfTwo ? static_cast<Index>(idx + count) : static_cast<Index>((idx + count) % Capacity);
+}
+
+/**
+ * \brief   Converts an index to a position in the storage.
+ * \param   idx     The index to convert.
+ * \return  The position in the storage.
+ */
+template<typename Element, size_t Size>
+inline size_t CircularFifo<Element, Size>::slot(Index idx)
+{
+    return PowerOfTwo ? (idx & (Size - 1)) : idx;
+}
+
+/**
+ * \brief   Calculates the number of elements in the buffer for the given tail and head.
+ * \param   tail    The tail (input) index.
+ * \param   head    The head (output) index.
+ * \return  The number of elements between head and tail.
+ */
+template<typename Element, size_t Size>
+inline size_t CircularFifo<Element, Size>::used(Index tail, Index head)
+{
+    return PowerOfTwo ? static_cast<Index>(tail - head) :
+                        ((tail >= head) ? (tail - head) : (tail + Capacity - head));
+}
+
+/**
+ * \brief   Checks if the buffer is full for the given tail and head.
+ * \param   tail    The tail (input) index.
+ * \param   head    The head (output) index.
+ * \return  True if no element can be added; false otherwise.
+ */
+template<typename Element, size_t Size>
+inline bool CircularFifo<Element, Size>::isFull(Index tail, Index head)
+{
+    return PowerOfTwo ? (static_cast<Index>(tail - head) == Size) : (increment(tail) == head);
+}
+
+/**
+ * \brief   Gets the element stored at the given index.
+ * \param   idx     The index of a constructed element.
+ * \return  Pointer to the element.
+ */
+template<typename Element, size_t Size>
+inline Element* CircularFifo<Element, Size>::element(Index idx)
+{
+    return reinterpret_cast<Element*>(&_array[slot(idx)]);
+}
+
+/**
+ * \brief   Gets the element stored at the given index.
+ * \param   idx     The index of a constructed element.
+ * \return  Pointer to the element.
+ */
+template<typename Element, size_t Size>
+inline const Element* CircularFifo<Element, Size>::element(Index idx) const
+{
+    return reinterpret_cast<const Element*>(&_array[slot(idx)]);
+}
+
+/**
+ * \brief   Destroys the elements from head up to tail.
+ * \param   head    The head (output) index.
+ * \param   tail    The tail (input) index.
+ */
+template<typename Element, size_t Size>
+void CircularFifo<Element, Size>::destroy(Index head, Index tail)
+{
+    for (; head != tail; head = increment(head))
+    {
+        element(head)->~Element();
+    }
 }
 
 #endif  // CIRCULARFIFO_HPP_
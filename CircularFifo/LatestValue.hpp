@@ -0,0 +1,212 @@
+/**
+ * \file    LatestValue.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \class   LatestValue
+ *
+ * \brief   Single-Writer, Multiple-Reader mailbox holding the most recent value.
+ *
+ * \details For consumers which only need the newest sample, not a queue. The
+ *          value is kept twice (double buffer): the writer updates the copy
+ *          which is not the current one and then advances the generation,
+ *          readers copy the current one. Every copy is guarded by a sequence
+ *          number (seqlock), a reader which was overtaken by two writes
+ *          during its copy notices and copies again. The writer never waits
+ *          for readers, readers never block the writer or each other.
+ *
+ *          'write()' is wait-free, 'read()' is lock-free but not wait-free:
+ *          there is no bound on its retries. A retry needs two writes during
+ *          a single copy, so a reader only starves while the writer keeps
+ *          writing faster than the value can be copied.
+ *
+ *          The value is copied word by word with relaxed atomics, which is
+ *          what makes the torn read well defined. Only trivially copyable
+ *          elements are allowed.
+ *
+ * \note    https://github.com/tlouwers/embedded/tree/master/CircularFifo
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef LATEST_VALUE_HPP_
+#define LATEST_VALUE_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CIRCULARFIFO_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the generation and
+ *          the copies. Define as 1 for targets without a data cache to save RAM.
+ */
+#ifndef CIRCULARFIFO_CACHE_LINE_SIZE
+#define CIRCULARFIFO_CACHE_LINE_SIZE    64
+#endif // CIRCULARFIFO_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename Element>
+class LatestValue
+{
+    static_assert(std::is_trivially_copyable<Element>::value, "LatestValue requires a trivially copyable element");
+
+public:
+    LatestValue();
+
+    LatestValue(const LatestValue&) = delete;
+    LatestValue& operator=(const LatestValue&) = delete;
+
+    void write(const Element& item);
+    bool read(Element& item) const;
+
+    size_t generation() const;
+    bool isLockFree() const;
+    void clear();
+
+private:
+    using Word = uintptr_t;
+    static constexpr size_t Words = (sizeof(Element) + sizeof(Word) - 1) / sizeof(Word);
+
+    static constexpr size_t Alignment = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(std::atomic<size_t>)) ?
+                                         CIRCULARFIFO_CACHE_LINE_SIZE : alignof(std::atomic<size_t>);
+
+    struct Copy
+    {
+        std::atomic<size_t> sequence;                           // Odd: being written, even: holds generation (sequence / 2)
+        std::atomic<Word>   data[Words];                        // The value, word by word
+    };
+
+    alignas(Alignment) std::atomic<size_t> _generation;         // Number of writes, owned by writer
+    alignas(Alignment) Copy _copies[2];                         // Current copy is _copies[_generation & 1]
+};
+
+/**
+ * \brief   Constructor, no value is written yet.
+ */
+template<typename Element>
+LatestValue<Element>::LatestValue() : _generation(0)
+{
+    clear();
+}
+
+/**
+ * \brief   Replaces the value.
+ * \param   item    The new value, copied into the mailbox.
+ * \note    This method is wait-free and can be called by a single writer.
+ */
+template<typename Element>
+void LatestValue<Element>::write(const Element& item)
+{
+    const auto current = _generation.load(std::memory_order_relaxed);
+    const auto next = current + 1;
+    Copy& copy = _copies[next & 1];                             // Not the one readers are sent to
+
+    Word words[Words] = {};
+    std::memcpy(words, &item, sizeof(Element));
+
+    copy.sequence.store((2 * next) - 1, std::memory_order_relaxed);                 // Odd: being written
+    std::atomic_thread_fence(std::memory_order_release);                            // Mark is visible before the data
+
+    for (size_t i = 0; i < Words; i++)
+    {
+        copy.data[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    copy.sequence.store(2 * next, std::memory_order_release);                      // Even: holds the generation
+    _generation.store(next, std::memory_order_release);
+}
+
+/**
+ * \brief   Copies the most recent value.
+ * \param   item    Reference to store the value.
+ * \return  True if a value was copied; false if nothing was written yet.
+ * \note    This method is lock-free and can be called by any number of
+ *          readers. It only copies again when the writer wrote twice during
+ *          the copy, the number of retries is not bounded.
+ */
+template<typename Element>
+bool LatestValue<Element>::read(Element& item) const
+{
+    for (;;)
+    {
+        const auto current = _generation.load(std::memory_order_acquire);
+        if (current == 0)
+        {
+            return false; // Nothing written yet
+        }
+
+        const Copy& copy = _copies[current & 1];
+        const auto before = copy.sequence.load(std::memory_order_acquire);
+
+        Word words[Words];
+        for (size_t i = 0; i < Words; i++)
+        {
+            words[i] = copy.data[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);                        // Data is read before the check
+        const auto after = copy.sequence.load(std::memory_order_relaxed);
+
+        if ((before == 2 * current) && (after == before))
+        {
+            std::memcpy(&item, words, sizeof(Element));
+            return true;
+        }
+        // Overwritten during the copy, a newer value is available
+    }
+}
+
+/**
+ * \brief   Gets the number of writes, to check for a new value without
+ *          copying it.
+ * \return  The generation of the current value, 0 if nothing was written yet.
+ */
+template<typename Element>
+size_t LatestValue<Element>::generation() const
+{
+    return _generation.load(std::memory_order_acquire);
+}
+
+/**
+ * \brief   Checks if atomic operations on the generation and copies are lock-free.
+ * \return  True if the atomic operations are lock-free; false otherwise.
+ */
+template<typename Element>
+bool LatestValue<Element>::isLockFree() const
+{
+    return _generation.is_lock_free() && _copies[0].sequence.is_lock_free() && _copies[0].data[0].is_lock_free();
+}
+
+/**
+ * \brief   Clears the mailbox, as if nothing was written yet.
+ * \note    This operation is not thread-safe and should be used with caution.
+ */
+template<typename Element>
+void LatestValue<Element>::clear()
+{
+    _copies[0].sequence.store(0, std::memory_order_relaxed);
+    _copies[1].sequence.store(0, std::memory_order_relaxed);
+    _generation.store(0, std::memory_order_release);
+}
+
+#endif  // LATEST_VALUE_HPP_
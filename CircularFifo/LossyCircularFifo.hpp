@@ -0,0 +1,276 @@
+/**
+ * \file    LossyCircularFifo.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \class   LossyCircularFifo
+ *
+ * \brief   Single-Producer, Single-Consumer circular buffer which overwrites
+ *          the oldest element when full.
+ *
+ * \details For telemetry streams where the newest data matters most: 'push()'
+ *          never fails, the producer is never held up by the consumer. Every
+ *          slot is guarded by a sequence number (seqlock). The producer marks
+ *          the slot as being written, stores the element and then marks it
+ *          as holding its position. The consumer copies the element and
+ *          checks the sequence before and after, an element which is
+ *          overwritten meanwhile is skipped. 'overruns()' counts the elements
+ *          the consumer lost.
+ *
+ *          The element is copied word by word with relaxed atomics, which is
+ *          what makes the torn read well defined. Only trivially copyable
+ *          elements are allowed. 'Size' must be a power of two.
+ *
+ * \note    https://github.com/tlouwers/embedded/tree/master/CircularFifo
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.0
+ * \date    10-2026
+ */
+
+#ifndef LOSSY_CIRCULARFIFO_HPP_
+#define LOSSY_CIRCULARFIFO_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CIRCULARFIFO_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the tail, head and
+ *          storage. Define as 1 for targets without a data cache to save RAM.
+ */
+#ifndef CIRCULARFIFO_CACHE_LINE_SIZE
+#define CIRCULARFIFO_CACHE_LINE_SIZE    64
+#endif // CIRCULARFIFO_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename Element, size_t Size>
+class LossyCircularFifo
+{
+    static_assert((Size > 0) && ((Size & (Size - 1)) == 0), "LossyCircularFifo requires a power of two size");
+    static_assert(std::is_trivially_copyable<Element>::value, "LossyCircularFifo requires a trivially copyable element");
+
+public:
+    static constexpr size_t Capacity = Size;                    // Number of slots in storage
+
+    LossyCircularFifo();
+
+    LossyCircularFifo(const LossyCircularFifo&) = delete;
+    LossyCircularFifo& operator=(const LossyCircularFifo&) = delete;
+
+    void push(const Element& item);
+    bool pop(Element& item);
+
+    bool empty() const;
+    size_t overruns() const;
+    bool isLockFree() const;
+    void clear();
+
+private:
+    using Word = uintptr_t;
+    static constexpr size_t Words = (sizeof(Element) + sizeof(Word) - 1) / sizeof(Word);
+
+    static constexpr size_t IndexAlignment = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(std::atomic<size_t>)) ?
+                                              CIRCULARFIFO_CACHE_LINE_SIZE : alignof(std::atomic<size_t>);
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;                           // Odd: being written, even: holds position (sequence / 2) - 1
+        std::atomic<Word>   data[Words];                        // The element, word by word
+    };
+
+    inline Slot& slot(size_t position);
+    static inline size_t written(size_t position);
+
+    alignas(IndexAlignment) std::atomic<size_t> _tail;          // Tail (input) position, owned by producer
+    alignas(IndexAlignment) std::atomic<size_t> _head;          // Head (output) position, owned by consumer
+    std::atomic<size_t> _overruns;                              // Elements lost, written by consumer
+    alignas(IndexAlignment) Slot _slots[Capacity];              // Circular buffer storage
+};
+
+/**
+ * \brief   Constructor, no slot holds an element yet.
+ */
+template<typename Element, size_t Size>
+LossyCircularFifo<Element, Size>::LossyCircularFifo() : _tail(0), _head(0), _overruns(0)
+{
+    clear();
+}
+
+/**
+ * \brief   Adds an item to the buffer, overwriting the oldest item when full.
+ * \param   item    The element to add, copied into the buffer.
+ * \note    This method is wait-free and can be called by a single producer.
+ */
+template<typename Element, size_t Size>
+void LossyCircularFifo<Element, Size>::push(const Element& item)
+{
+    const auto current_tail = _tail.load(std::memory_order_relaxed);
+    Slot& current = slot(current_tail);
+
+    Word words[Words] = {};
+    std::memcpy(words, &item, sizeof(Element));
+
+    current.sequence.store(written(current_tail) - 1, std::memory_order_relaxed);  // Odd: being written
+    std::atomic_thread_fence(std::memory_order_release);                            // Mark is visible before the data
+
+    for (size_t i = 0; i < Words; i++)
+    {
+        current.data[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    current.sequence.store(written(current_tail), std::memory_order_release);      // Even: holds the position
+    _tail.store(current_tail + 1, std::memory_order_release);
+}
+
+/**
+ * \brief   Removes the oldest item which was not overwritten from the buffer.
+ * \param   item    Reference to store the removed element.
+ * \return  True if an item was removed successfully; false if the buffer is empty.
+ * \note    This method is lock-free and can be called by a single consumer.
+ *          It retries only when the producer overwrote the element during
+ *          the copy.
+ */
+template<typename Element, size_t Size>
+bool LossyCircularFifo<Element, Size>::pop(Element& item)
+{
+    auto current_head = _head.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const auto current_tail = _tail.load(std::memory_order_acquire);
+
+        if (current_head == current_tail)
+        {
+            _head.store(current_head, std::memory_order_release);
+            return false; // Buffer is empty
+        }
+
+        if ((current_tail - current_head) > Size)
+        {
+            // Overwritten while we were away: continue at the oldest element still present
+            const auto lost = current_tail - current_head - Size;
+            _overruns.store(_overruns.load(std::memory_order_relaxed) + lost, std::memory_order_relaxed);
+            current_head += lost;
+        }
+
+        Slot& current = slot(current_head);
+        const auto before = current.sequence.load(std::memory_order_acquire);
+
+        Word words[Words];
+        for (size_t i = 0; i < Words; i++)
+        {
+            words[i] = current.data[i].load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);                        // Data is read before the check
+        const auto after = current.sequence.load(std::memory_order_relaxed);
+
+        if ((before != written(current_head)) || (after != before))
+        {
+            // Being overwritten, or overwritten during the copy
+            _overruns.store(_overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            current_head++;
+            continue;
+        }
+
+        std::memcpy(&item, words, sizeof(Element));
+        _head.store(current_head + 1, std::memory_order_release);
+        return true;
+    }
+}
+
+/**
+ * \brief   Checks if the buffer is empty.
+ * \remark  This is a snapshot; the queue status may change by either producer
+ *          or consumer before the other accesses it.
+ * \return  True if the buffer is empty; false otherwise.
+ */
+template<typename Element, size_t Size>
+bool LossyCircularFifo<Element, Size>::empty() const
+{
+    // Snapshot with acceptance that this comparison operation is not atomic.
+    return _head.load() == _tail.load();
+}
+
+/**
+ * \brief   Gets the number of elements which were overwritten before the
+ *          consumer could remove them.
+ * \return  The number of lost elements since construction or 'clear()'.
+ * \note    Counted by the consumer, in 'pop()'.
+ */
+template<typename Element, size_t Size>
+size_t LossyCircularFifo<Element, Size>::overruns() const
+{
+    return _overruns.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Checks if atomic operations on the positions and slots are lock-free.
+ * \return  True if the atomic operations are lock-free; false otherwise.
+ */
+template<typename Element, size_t Size>
+bool LossyCircularFifo<Element, Size>::isLockFree() const
+{
+    return _tail.is_lock_free() && _head.is_lock_free() && _slots[0].data[0].is_lock_free();
+}
+
+/**
+ * \brief   Clears the buffer by resetting the positions, sequences and the
+ *          overrun counter to zero.
+ * \note    This operation is not thread-safe and should be used with caution.
+ */
+template<typename Element, size_t Size>
+void LossyCircularFifo<Element, Size>::clear()
+{
+    for (size_t i = 0; i < Size; i++)
+    {
+        _slots[i].sequence.store(0, std::memory_order_relaxed);    // Holds no position
+    }
+
+    _overruns.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_release);
+    _head.store(0, std::memory_order_release);
+}
+
+/**
+ * \brief   Gets the slot for the given position.
+ * \param   position    The free running position.
+ * \return  The slot.
+ */
+template<typename Element, size_t Size>
+inline typename LossyCircularFifo<Element, Size>::Slot& LossyCircularFifo<Element, Size>::slot(size_t position)
+{
+    return _slots[position & (Size - 1)];
+}
+
+/**
+ * \brief   Gets the sequence of a slot which holds the given position.
+ * \param   position    The free running position.
+ * \return  The (even) sequence, the sequence while writing is one less.
+ */
+template<typename Element, size_t Size>
+inline size_t LossyCircularFifo<Element, Size>::written(size_t position)
+{
+    return (2 * position) + 2;
+}
+
+#endif  // LOSSY_CIRCULARFIFO_HPP_
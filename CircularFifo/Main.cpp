@@ -0,0 +1,219 @@
+// Moves a heavy element type, a request holding a std::function like the
+// I2C arbiter queues, from a producer to a consumer thread with the
+// different push and pop methods and reports the throughput of each.
+// Then compares reaching the most recent sample through LatestValue with
+// draining a CircularFifo to its last element.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include "CircularFifo.hpp"
+#include "LatestValue.hpp"
+
+struct Request
+{
+    bool is_write_request = false;
+    uint8_t header[8] = {};
+    uint8_t* ptrData = nullptr;
+    size_t length = 0;
+    std::function<void()> callbackDone = nullptr;
+
+    Request() = default;
+    Request(bool write, size_t len, std::function<void()> callback) :
+        is_write_request(write), length(len), callbackDone(std::move(callback)) {}
+};
+
+static constexpr size_t Items = 1000000;
+static constexpr size_t Batch = 16;
+
+static CircularFifo<Request, 64> fifo;
+static size_t counter = 0;
+
+struct Sample
+{
+    uint64_t sequence = 0;
+    uint64_t stamp = 0;
+    int32_t values[6] = {};
+};
+
+static CircularFifo<Sample, 64> samples;
+static LatestValue<Sample> latest;
+
+static uint64_t Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static std::function<void()> MakeCallback(size_t i)
+{
+    // Captures more than fits in the small buffer of std::function, as a
+    // callback bound to an object and some context typically does.
+    const size_t a = i, b = i + 1, c = i + 2;
+    return [a, b, c]() { counter += a + b + c; };
+}
+
+template<typename Produce, typename Consume>
+static void Run(const char* name, Produce produce, Consume consume)
+{
+    fifo.clear();
+    counter = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer(produce);
+    consume();
+    producer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << name << ": " << static_cast<uint64_t>(Items / seconds) << " items/s" << std::endl;
+}
+
+// The writer publishes Items samples, the reader wants the newest one each
+// time it looks. Reports the write rate, how often the reader got a new
+// sample and the mean age of the sample it got.
+template<typename Produce, typename Newest>
+static void RunSamples(const char* name, Produce produce, Newest newest)
+{
+    samples.clear();
+    latest.clear();
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer(produce);
+
+    Sample sample;
+    uint64_t last = 0;
+    uint64_t reads = 0;
+    uint64_t age = 0;
+    while (last != Items)
+    {
+        if (!newest(sample) || (sample.sequence == last))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        age += Now() - sample.stamp;
+        last = sample.sequence;
+        reads++;
+    }
+    producer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << name << ": " << static_cast<uint64_t>(Items / seconds) << " writes/s, "
+              << reads << " new samples read, mean age " << (age / reads) << " ns" << std::endl;
+}
+
+static Sample MakeSample(size_t i)
+{
+    Sample sample;
+    sample.sequence = i;
+    sample.stamp = Now();
+    return sample;
+}
+
+static void Consume()
+{
+    Request request;
+    for (size_t i = 0; i < Items; i++)
+    {
+        while (!fifo.pop(request)) { std::this_thread::yield(); }
+        request.callbackDone();
+    }
+}
+
+int main(void)
+{
+    Run("push (copy), pop",
+        []() {
+            for (size_t i = 0; i < Items; i++)
+            {
+                const Request request(true, i, MakeCallback(i));
+                while (!fifo.push(request)) { std::this_thread::yield(); }
+            }
+        },
+        Consume);
+
+    Run("push (move), pop",
+        []() {
+            for (size_t i = 0; i < Items; i++)
+            {
+                Request request(true, i, MakeCallback(i));
+                while (!fifo.push(std::move(request))) { std::this_thread::yield(); }
+            }
+        },
+        Consume);
+
+    Run("emplace, pop",
+        []() {
+            for (size_t i = 0; i < Items; i++)
+            {
+                while (!fifo.emplace(true, i, MakeCallback(i))) { std::this_thread::yield(); }
+            }
+        },
+        Consume);
+
+    Run("push_n, pop_n",
+        []() {
+            Request requests[Batch];
+            for (size_t i = 0; i < Items; i += Batch)
+            {
+                for (size_t j = 0; j < Batch; j++)
+                {
+                    requests[j] = Request(true, i + j, MakeCallback(i + j));
+                }
+                size_t pushed = 0;
+                while (pushed < Batch)
+                {
+                    pushed += fifo.push_n(&requests[pushed], Batch - pushed);
+                    if (pushed < Batch) { std::this_thread::yield(); }
+                }
+            }
+        },
+        []() {
+            Request requests[Batch];
+            size_t received = 0;
+            while (received < Items)
+            {
+                const size_t count = fifo.pop_n(requests, Batch);
+                for (size_t j = 0; j < count; j++)
+                {
+                    requests[j].callbackDone();
+                }
+                received += count;
+                if (count == 0) { std::this_thread::yield(); }
+            }
+        });
+
+    RunSamples("CircularFifo, drain to newest",
+        []() {
+            for (size_t i = 1; i <= Items; i++)
+            {
+                while (!samples.push(MakeSample(i))) { std::this_thread::yield(); }
+            }
+        },
+        [](Sample& sample) {
+            bool found = false;
+            while (samples.pop(sample)) { found = true; }
+            return found;
+        });
+
+    RunSamples("LatestValue, read",
+        []() {
+            for (size_t i = 1; i <= Items; i++)
+            {
+                latest.write(MakeSample(i));
+            }
+        },
+        [](Sample& sample) {
+            return latest.read(sample);
+        });
+
+    return 0;
+}
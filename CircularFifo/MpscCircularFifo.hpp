@@ -0,0 +1,474 @@
+/**
+ * \file    MpscCircularFifo.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \class   MpscCircularFifo
+ *
+ * \brief   Multi-Producer, Single-Consumer, lock-free circular buffer.
+ *
+ * \details Every slot holds a sequence number next to the element, after
+ *          Dmitry Vyukov's bounded MPMC queue. A producer claims a slot with
+ *          a single CAS on the tail and publishes it by storing the sequence.
+ *          The single consumer is wait-free: it checks the sequence of the
+ *          head slot, there is no CAS on the consumer side.
+ *
+ *          The interface follows CircularFifo, including 'front()' and
+ *          'pop()' to use the head element in place. 'Size' must be a power
+ *          of two, the positions are free running and wrapped with a mask.
+ *          They are size_t, a narrower type could wrap around while a
+ *          preempted producer holds a stale tail (ABA on the CAS).
+ *
+ * \remarks A producer which is preempted between claiming and publishing its
+ *          slot delays the consumer: the elements behind it are not visible
+ *          until it is published, the buffer appears empty in the meantime.
+ *          A claimed slot must always be published, else the consumer stalls
+ *          on it forever: constructing an element may not throw. Push by move
+ *          when only the move constructor is nothrow.
+ *
+ * \note    http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.3
+ * \date    10-2026
+ */
+
+#ifndef MPSC_CIRCULARFIFO_HPP_
+#define MPSC_CIRCULARFIFO_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CIRCULARFIFO_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the tail, head and
+ *          storage. Define as 1 for targets without a data cache to save RAM.
+ */
+#ifndef CIRCULARFIFO_CACHE_LINE_SIZE
+#define CIRCULARFIFO_CACHE_LINE_SIZE    64
+#endif // CIRCULARFIFO_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename Element, size_t Size>
+class MpscCircularFifo
+{
+    static_assert((Size > 0) && ((Size & (Size - 1)) == 0), "MpscCircularFifo requires a power of two size");
+
+public:
+    static constexpr size_t Capacity = Size;                    // Number of slots in storage
+
+    MpscCircularFifo();
+    ~MpscCircularFifo();
+
+    MpscCircularFifo(const MpscCircularFifo&) = delete;
+    MpscCircularFifo& operator=(const MpscCircularFifo&) = delete;
+
+    bool push(const Element& item);
+    bool push(Element&& item);
+    template<typename... Args>
+    bool emplace(Args&&... args);
+    bool pop(Element& item);
+    bool pop();
+    bool peek(Element& item) const;
+    Element* front();
+    const Element* front() const;
+
+    bool empty() const;
+    bool isLockFree() const;
+    void clear();
+
+#ifdef DEBUG
+    void SetState(size_t position);
+#endif // DEBUG
+
+private:
+    static constexpr size_t IndexAlignment   = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(std::atomic<size_t>)) ?
+                                                CIRCULARFIFO_CACHE_LINE_SIZE : alignof(std::atomic<size_t>);
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence;                           // Position the slot is ready for
+        typename std::aligned_storage<sizeof(Element), alignof(Element)>::type storage;    // Raw, unconstructed element
+    };
+
+    static constexpr size_t SlotAlignment    = (CIRCULARFIFO_CACHE_LINE_SIZE > alignof(Slot)) ?
+                                                CIRCULARFIFO_CACHE_LINE_SIZE : alignof(Slot);
+
+    inline bool claim(size_t& position);
+    inline Slot& slot(size_t position);
+    inline const Slot& slot(size_t position) const;
+    static inline Element* element(Slot& slot);
+    static inline const Element* element(const Slot& slot);
+    void reset();
+
+    alignas(IndexAlignment) std::atomic<size_t> _tail;          // Tail (input) position, shared by producers
+    alignas(IndexAlignment) std::atomic<size_t> _head;          // Head (output) position, owned by consumer
+    alignas(SlotAlignment)  Slot _slots[Capacity];              // Circular buffer storage
+};
+
+/**
+ * \brief   Constructor, all slots are free for the first lap.
+ */
+template<typename Element, size_t Size>
+MpscCircularFifo<Element, Size>::MpscCircularFifo() : _tail(0), _head(0)
+{
+    reset();
+}
+
+/**
+ * \brief   Destructor, destroys the elements still in the buffer.
+ */
+template<typename Element, size_t Size>
+MpscCircularFifo<Element, Size>::~MpscCircularFifo()
+{
+    clear();
+}
+
+/**
+ * \brief   Adds an item to the buffer.
+ * \param   item    The element to add, copied into the buffer.
+ * \return  True if the item was added successfully; false if the buffer is full.
+ * \note    This method is thread-safe and can be called by multiple producers.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::push(const Element& item)
+{
+    return emplace(item);
+}
+
+/**
+ * \brief   Adds an item to the buffer.
+ * \param   item    The element to add, moved into the buffer.
+ * \return  True if the item was added successfully; false if the buffer is full,
+ *          the item is left untouched then.
+ * \note    This method is thread-safe and can be called by multiple producers.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::push(Element&& item)
+{
+    return emplace(std::move(item));
+}
+
+/**
+ * \brief   Constructs an item in place in a claimed slot.
+ * \details Requires a constructor which does not throw for 'args'.
+ * \param   args    The arguments passed to the constructor of the element.
+ * \return  True if the item was added successfully; false if the buffer is full.
+ * \note    This method is thread-safe and can be called by multiple producers.
+ */
+template<typename Element, size_t Size>
+template<typename... Args>
+bool MpscCircularFifo<Element, Size>::emplace(Args&&... args)
+{
+    static_assert(std::is_nothrow_constructible<Element, Args&&...>::value, "A claimed slot must be published, constructing may not throw");
+
+    size_t position;
+    if (!claim(position))
+    {
+        return false; // Buffer is full
+    }
+
+    Slot& current = slot(position);
+    new (element(current)) Element(std::forward<Args>(args)...);
+    current.sequence.store(position + 1, std::memory_order_release);    // Publish to the consumer
+    return true;
+}
+
+/**
+ * \brief   Removes an item from the buffer.
+ * \param   item    Reference to store the removed element, moved out of the buffer.
+ * \return  True if an item was removed successfully; false if the buffer is
+ *          empty or the head slot is claimed but not yet published.
+ * \note    This method is wait-free and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::pop(Element& item)
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    Slot& current = slot(current_head);
+
+    if (current.sequence.load(std::memory_order_acquire) != (current_head + 1))
+    {
+        return false; // Buffer is empty
+    }
+
+    Element* stored = element(current);
+    item = std::move(*stored);
+    stored->~Element();
+    current.sequence.store(current_head + Size, std::memory_order_release);  // Free for the next lap
+    _head.store(current_head + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * \brief   Peeks at the item at the head of the buffer without removing it.
+ * \param   item    Reference to store the peeked element.
+ * \return  True if an item was peeked successfully; false if the buffer is
+ *          empty or the head slot is claimed but not yet published.
+ * \note    This method is wait-free and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::peek(Element& item) const
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    const Slot& current = slot(current_head);
+
+    if (current.sequence.load(std::memory_order_acquire) != (current_head + 1))
+    {
+        return false; // Buffer is empty
+    }
+
+    item = *element(current);
+    return true;
+}
+
+/**
+ * \brief   Removes the item at the head of the buffer, without moving it out.
+ * \return  True if an item was removed successfully; false if the buffer is empty or the
+ *          head slot is claimed but not yet published.
+ * \note    This method is wait-free and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::pop()
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    Slot& current = slot(current_head);
+
+    if (current.sequence.load(std::memory_order_acquire) != (current_head + 1))
+    {
+        return false; // Buffer is empty
+    }
+
+    element(current)->~Element();
+    current.sequence.store(current_head + Size, std::memory_order_release);  // Free for the next lap
+    _head.store(current_head + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * \brief   Gets the item at the head of the buffer, to use it in place.
+ * \return  Pointer to the head element; nullptr if the buffer is empty or the
+ *          head slot is claimed but not yet published.
+ *          The element remains valid until it is removed with 'pop()'.
+ * \note    This method is wait-free and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+Element* MpscCircularFifo<Element, Size>::front()
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    Slot& current = slot(current_head);
+
+    if (current.sequence.load(std::memory_order_acquire) != (current_head + 1))
+    {
+        return nullptr; // Buffer is empty
+    }
+
+    return element(current);
+}
+
+/**
+ * \brief   Gets the item at the head of the buffer, to use it in place.
+ * \return  Pointer to the head element; nullptr if the buffer is empty or the
+ *          head slot is claimed but not yet published.
+ *          The element remains valid until it is removed with 'pop()'.
+ * \note    This method is wait-free and can be called by a single consumer.
+ */
+template<typename Element, size_t Size>
+const Element* MpscCircularFifo<Element, Size>::front() const
+{
+    const auto current_head = _head.load(std::memory_order_relaxed);
+    const Slot& current = slot(current_head);
+
+    if (current.sequence.load(std::memory_order_acquire) != (current_head + 1))
+    {
+        return nullptr; // Buffer is empty
+    }
+
+    return element(current);
+}
+
+/**
+ * \brief   Checks if the buffer is empty, as seen by the consumer.
+ * \remark  This is a snapshot; the queue status may change by either producers
+ *          or consumer before the other accesses it. A claimed but not yet
+ *          published head slot counts as empty.
+ * \return  True if the buffer is empty; false otherwise.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::empty() const
+{
+    const auto current_head = _head.load(std::memory_order_acquire);
+    return slot(current_head).sequence.load(std::memory_order_acquire) != (current_head + 1);
+}
+
+/**
+ * \brief   Checks if atomic operations on the head, tail and sequences are lock-free.
+ * \return  True if the atomic operations are lock-free; false otherwise.
+ */
+template<typename Element, size_t Size>
+bool MpscCircularFifo<Element, Size>::isLockFree() const
+{
+    return _tail.is_lock_free() && _head.is_lock_free() && _slots[0].sequence.is_lock_free();
+}
+
+/**
+ * \brief   Clears the buffer by destroying the published elements and
+ *          resetting the positions and sequences.
+ * \note    This operation is not thread-safe and should be used with caution.
+ *          No producer may be between claiming and publishing a slot.
+ */
+template<typename Element, size_t Size>
+void MpscCircularFifo<Element, Size>::clear()
+{
+    const auto tail = _tail.load(std::memory_order_acquire);
+
+    for (auto position = _head.load(std::memory_order_acquire); position != tail; position++)
+    {
+        Slot& current = slot(position);
+        if (current.sequence.load(std::memory_order_acquire) == (position + 1))
+        {
+            element(current)->~Element();                       // Only destroy published elements
+        }
+    }
+
+    reset();
+}
+
+#ifdef DEBUG
+/**
+ * \brief   Debug method to start the head and tail at 'position', for
+ *          instance just before the positions wrap around.
+ * \param   position    Value to set the head and tail to.
+ * \remarks There are no checks, so know what you are doing! The buffer must
+ *          be empty and no producer or consumer may access it.
+ */
+template<typename Element, size_t Size>
+void MpscCircularFifo<Element, Size>::SetState(size_t position)
+{
+    #warning DEBUG method SetState() enabled - carefull, there be dragons here.
+
+    for (size_t i = 0; i < Size; i++)
+    {
+        slot(position + i).sequence.store(position + i, std::memory_order_relaxed);
+    }
+
+    _tail.store(position, std::memory_order_release);
+    _head.store(position, std::memory_order_release);
+}
+#endif // DEBUG
+
+/**
+ * \brief   Claims the slot at the tail for writing.
+ * \details A slot whose sequence equals the position is free for the current
+ *          lap, the tail is advanced with a single CAS. A sequence ahead of
+ *          the position means another producer claimed it: retry from the new
+ *          tail. A sequence behind means it is not consumed yet: full.
+ * \param   position    Updated to the claimed position.
+ * \return  True if the slot is claimed, false if the buffer is full.
+ */
+template<typename Element, size_t Size>
+inline bool MpscCircularFifo<Element, Size>::claim(size_t& position)
+{
+    position = _tail.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const auto sequence = slot(position).sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (diff == 0)
+        {
+            if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false;                                       // Not consumed yet: buffer full
+        }
+        else
+        {
+            position = _tail.load(std::memory_order_relaxed);   // Claimed by another producer
+        }
+    }
+}
+
+/**
+ * \brief   Gets the slot for the given position.
+ * \param   position    The free running position.
+ * \return  The slot.
+ */
+template<typename Element, size_t Size>
+inline typename MpscCircularFifo<Element, Size>::Slot& MpscCircularFifo<Element, Size>::slot(size_t position)
+{
+    return _slots[position & (Size - 1)];
+}
+
+/**
+ * \brief   Gets the slot for the given position.
+ * \param   position    The free running position.
+ * \return  The slot.
+ */
+template<typename Element, size_t Size>
+inline const typename MpscCircularFifo<Element, Size>::Slot& MpscCircularFifo<Element, Size>::slot(size_t position) const
+{
+    return _slots[position & (Size - 1)];
+}
+
+/**
+ * \brief   Gets the element stored in the given slot.
+ * \param   slot    The slot holding a constructed element.
+ * \return  Pointer to the element.
+ */
+template<typename Element, size_t Size>
+inline Element* MpscCircularFifo<Element, Size>::element(Slot& slot)
+{
+    return reinterpret_cast<Element*>(&slot.storage);
+}
+
+/**
+ * \brief   Gets the element stored in the given slot.
+ * \param   slot    The slot holding a constructed element.
+ * \return  Pointer to the element.
+ */
+template<typename Element, size_t Size>
+inline const Element* MpscCircularFifo<Element, Size>::element(const Slot& slot)
+{
+    return reinterpret_cast<const Element*>(&slot.storage);
+}
+
+/**
+ * \brief   Resets the positions to zero and frees all slots for the first lap.
+ */
+template<typename Element, size_t Size>
+void MpscCircularFifo<Element, Size>::reset()
+{
+    for (size_t i = 0; i < Size; i++)
+    {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    _tail.store(0, std::memory_order_release);
+    _head.store(0, std::memory_order_release);
+}
+
+#endif  // MPSC_CIRCULARFIFO_HPP_
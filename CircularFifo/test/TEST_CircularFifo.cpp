@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+#include "CircularFifo.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// The narrowest index type holding 'Size'
+static_assert(std::is_same<CircularFifoIndex<1>,   uint8_t>::value,  "Index of CircularFifo<T, 1>");
+static_assert(std::is_same<CircularFifoIndex<128>, uint8_t>::value,  "Index of CircularFifo<T, 128>");
+static_assert(std::is_same<CircularFifoIndex<255>, uint8_t>::value,  "Index of CircularFifo<T, 255>");
+static_assert(std::is_same<CircularFifoIndex<256>, uint16_t>::value, "Index of CircularFifo<T, 256>");
+static_assert(std::is_same<CircularFifoIndex<65535>, uint16_t>::value, "Index of CircularFifo<T, 65535>");
+static_assert(std::is_same<CircularFifoIndex<65536>, uint32_t>::value, "Index of CircularFifo<T, 65536>");
+
+// A power of two size needs no additional element, other sizes do
+static_assert(CircularFifo<int, 4>::PowerOfTwo,                     "4 is a power of two");
+static_assert(CircularFifo<int, 4>::Capacity == 4,                  "No additional element");
+static_assert(CircularFifo<int, 128>::Capacity == 128,              "No additional element");
+static_assert(!CircularFifo<int, 5>::PowerOfTwo,                    "5 is not a power of two");
+static_assert(CircularFifo<int, 5>::Capacity == 6,                  "One additional element");
+static_assert(CircularFifo<int, 255>::Capacity == 256,              "One additional element");
+
+
+// Counts the live instances, a missing or second destruction shows up as a leak or a negative count
+struct Counted {
+    static int live;
+    int value;
+
+    explicit Counted(int v = 0) : value(v) { live++; }
+    Counted(const Counted& other) : value(other.value) { live++; }
+    Counted(Counted&& other) noexcept : value(other.value) { live++; }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) noexcept = default;
+    ~Counted() { live--; }
+};
+int Counted::live = 0;
+
+
+template<typename Fifo>
+void FillAndDrain(Fifo& fifo, const size_t size) {
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_FALSE(fifo.full());
+
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_FALSE(fifo.full());
+        EXPECT_TRUE(fifo.push(static_cast<int>(i)));
+        EXPECT_FALSE(fifo.empty());
+    }
+    EXPECT_TRUE(fifo.full());                               // Full at exactly 'Size'
+    EXPECT_FALSE(fifo.push(-1));
+
+    int item = -1;
+    for (size_t i = 0; i < size; i++) {
+        EXPECT_TRUE(fifo.pop(item));
+        EXPECT_EQ(item, static_cast<int>(i));
+    }
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_FALSE(fifo.pop(item));
+}
+
+TEST(TEST_CircularFifo, InitialState) {
+    CircularFifo<int, 4> fifo;
+    int item = -1;
+
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_FALSE(fifo.full());
+    EXPECT_TRUE(fifo.isLockFree());
+    EXPECT_FALSE(fifo.pop(item));
+    EXPECT_FALSE(fifo.peek(item));
+    EXPECT_EQ(item, -1);
+}
+
+TEST(TEST_CircularFifo, FullAndEmptyPowerOfTwo) {
+    CircularFifo<int, 4> small;
+    FillAndDrain(small, 4);
+
+    CircularFifo<int, 128> large;
+    FillAndDrain(large, 128);
+}
+
+TEST(TEST_CircularFifo, FullAndEmptyOtherSize) {
+    CircularFifo<int, 5> small;
+    FillAndDrain(small, 5);
+
+    CircularFifo<int, 255> large;                           // Capacity 256, indices up to 255 in uint8_t
+    FillAndDrain(large, 255);
+}
+
+TEST(TEST_CircularFifo, FullAndEmptyWideIndex) {
+    CircularFifo<int, 256> fifo;                            // uint16_t indices
+    FillAndDrain(fifo, 256);
+}
+
+TEST(TEST_CircularFifo, FreeRunningIndexWrap) {
+    CircularFifo<int, 4> fifo;                              // uint8_t indices, free running
+    int next = 0;
+    int expected = 0;
+    int item = -1;
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(fifo.push(next++));
+    }
+
+    // Pass the 255 -> 0 wrap of the indices a few times, full at every offset
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(fifo.push(next++));
+        EXPECT_TRUE(fifo.full());
+        EXPECT_FALSE(fifo.push(-1));
+
+        EXPECT_TRUE(fifo.pop(item));
+        EXPECT_EQ(item, expected++);
+        EXPECT_FALSE(fifo.full());
+        EXPECT_FALSE(fifo.empty());
+    }
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(fifo.pop(item));
+        EXPECT_EQ(item, expected++);
+    }
+    EXPECT_TRUE(fifo.empty());
+}
+
+TEST(TEST_CircularFifo, ModuloIndexWrap) {
+    CircularFifo<int, 255> fifo;                            // uint8_t indices, wrap at the capacity of 256
+    int next = 0;
+    int expected = 0;
+    int item = -1;
+
+    for (int lap = 0; lap < 4; lap++) {
+        for (int i = 0; i < 200; i++) {
+            EXPECT_TRUE(fifo.push(next++));
+        }
+        for (int i = 0; i < 200; i++) {
+            EXPECT_TRUE(fifo.pop(item));
+            EXPECT_EQ(item, expected++);
+        }
+    }
+    EXPECT_TRUE(fifo.empty());
+}
+
+TEST(TEST_CircularFifo, Clear) {
+    CircularFifo<int, 4> fifo;
+    int item = -1;
+
+    EXPECT_TRUE(fifo.push(1));
+    EXPECT_TRUE(fifo.push(2));
+    fifo.clear();
+
+    EXPECT_TRUE(fifo.empty());
+    EXPECT_FALSE(fifo.pop(item));
+    FillAndDrain(fifo, 4);                                  // Usable after clear
+}
+
+TEST(TEST_CircularFifo, PopDestroysOnce) {
+    Counted::live = 0;
+    {
+        CircularFifo<Counted, 4> fifo;
+        EXPECT_TRUE(fifo.emplace(1));
+        EXPECT_TRUE(fifo.emplace(2));
+        EXPECT_TRUE(fifo.push(Counted(3)));                 // Temporary is destroyed, the moved copy remains
+        EXPECT_EQ(Counted::live, 3);
+
+        Counted item;
+        EXPECT_EQ(Counted::live, 4);
+        EXPECT_TRUE(fifo.pop(item));
+        EXPECT_EQ(item.value, 1);
+        EXPECT_EQ(Counted::live, 3);                        // Two in the fifo, one popped
+
+        EXPECT_TRUE(fifo.pop());
+        EXPECT_EQ(Counted::live, 2);
+    }
+    EXPECT_EQ(Counted::live, 0);                            // Destructor destroyed the last element
+}
+
+TEST(TEST_CircularFifo, ClearAndDestructorDestroyOnce) {
+    Counted::live = 0;
+    {
+        CircularFifo<Counted, 5> fifo;
+        for (int i = 0; i < 5; i++) {
+            EXPECT_TRUE(fifo.emplace(i));
+        }
+        EXPECT_EQ(Counted::live, 5);
+
+        fifo.clear();
+        EXPECT_EQ(Counted::live, 0);
+        EXPECT_TRUE(fifo.empty());
+
+        EXPECT_TRUE(fifo.emplace(10));                      // Left for the destructor, across the wrap
+        Counted item;
+        for (int lap = 0; lap < 7; lap++) {
+            EXPECT_TRUE(fifo.emplace(lap));
+            EXPECT_TRUE(fifo.pop(item));
+        }
+        EXPECT_EQ(Counted::live, 2);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(TEST_CircularFifo, StringElements) {
+    CircularFifo<std::string, 2> fifo;
+    const std::string text(64, 'a');                        // Beyond the small string buffer
+
+    EXPECT_TRUE(fifo.push(text));
+    EXPECT_TRUE(fifo.emplace(32, 'b'));
+    EXPECT_TRUE(fifo.full());
+
+    std::string moved(64, 'c');
+    EXPECT_FALSE(fifo.push(std::move(moved)));              // Full: the source is left untouched
+    EXPECT_EQ(moved, std::string(64, 'c'));
+
+    std::string item;
+    EXPECT_TRUE(fifo.pop(item));
+    EXPECT_EQ(item, text);
+
+    EXPECT_TRUE(fifo.push(std::move(moved)));               // Space: the source is moved from
+    EXPECT_TRUE(fifo.pop(item));
+    EXPECT_EQ(item, std::string(32, 'b'));
+    EXPECT_TRUE(fifo.pop(item));
+    EXPECT_EQ(item, std::string(64, 'c'));
+    EXPECT_TRUE(fifo.empty());
+}
+
+template<typename Fifo>
+void BulkTransfer(Fifo& fifo, const size_t size) {
+    int src[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    int dest[8] = { };
+
+    EXPECT_EQ(fifo.pop_n(dest, 8), 0);                      // Empty
+    EXPECT_EQ(fifo.push_n(src, 0), 0);
+
+    // Move the indices near the end of the storage
+    EXPECT_EQ(fifo.push_n(src, size - 1), size - 1);
+    EXPECT_EQ(fifo.pop_n(dest, size - 1), size - 1);
+    EXPECT_TRUE(fifo.empty());
+
+    // Clamped to the free space, wraps across the end of the storage
+    EXPECT_EQ(fifo.push_n(src, 8), size);
+    EXPECT_TRUE(fifo.full());
+    EXPECT_EQ(fifo.push_n(src, 1), 0);                      // Full
+
+    // Clamped to the queued items, in order
+    EXPECT_EQ(fifo.pop_n(dest, 2), 2);
+    EXPECT_EQ(dest[0], 0);
+    EXPECT_EQ(dest[1], 1);
+    EXPECT_EQ(fifo.push_n(&src[6], 2), 2);
+    EXPECT_EQ(fifo.pop_n(dest, 8), size);
+    for (size_t i = 0; i < size - 2; i++) {
+        EXPECT_EQ(dest[i], static_cast<int>(i + 2));
+    }
+    EXPECT_EQ(dest[size - 2], 6);
+    EXPECT_EQ(dest[size - 1], 7);
+    EXPECT_TRUE(fifo.empty());
+}
+
+TEST(TEST_CircularFifo, BulkTransferPowerOfTwo) {
+    CircularFifo<int, 4> fifo;
+    BulkTransfer(fifo, 4);
+}
+
+TEST(TEST_CircularFifo, BulkTransferOtherSize) {
+    CircularFifo<int, 5> fifo;
+    BulkTransfer(fifo, 5);
+}
+
+TEST(TEST_CircularFifo, BulkTransferDestroysOnce) {
+    Counted::live = 0;
+    {
+        CircularFifo<Counted, 4> fifo;
+        Counted src[3] = { Counted(1), Counted(2), Counted(3) };
+        Counted dest[3];
+        EXPECT_EQ(Counted::live, 6);
+
+        EXPECT_EQ(fifo.push_n(src, 3), 3);
+        EXPECT_EQ(Counted::live, 9);
+        EXPECT_EQ(fifo.pop_n(dest, 2), 2);
+        EXPECT_EQ(Counted::live, 7);
+        EXPECT_EQ(dest[0].value, 1);
+        EXPECT_EQ(dest[1].value, 2);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST(TEST_CircularFifo, FrontWhenEmpty) {
+    CircularFifo<int, 4> fifo;
+    const auto& constFifo = fifo;
+
+    EXPECT_EQ(fifo.front(), nullptr);
+    EXPECT_EQ(constFifo.front(), nullptr);
+    EXPECT_FALSE(fifo.pop());
+
+    EXPECT_TRUE(fifo.push(1));
+    EXPECT_TRUE(fifo.pop());
+    EXPECT_EQ(fifo.front(), nullptr);                       // Empty again
+}
+
+TEST(TEST_CircularFifo, FrontInPlace) {
+    CircularFifo<int, 5> fifo;
+    EXPECT_TRUE(fifo.push(1));
+    EXPECT_TRUE(fifo.push(2));
+
+    int* head = fifo.front();
+    ASSERT_NE(head, nullptr);
+    EXPECT_EQ(*head, 1);
+    *head = 10;                                             // Modified in place
+
+    const auto& constFifo = fifo;
+    ASSERT_NE(constFifo.front(), nullptr);
+    EXPECT_EQ(constFifo.front(), head);                     // Same element
+    EXPECT_EQ(*constFifo.front(), 10);
+
+    int item = -1;
+    EXPECT_TRUE(fifo.pop(item));                            // Sees the modification
+    EXPECT_EQ(item, 10);
+    ASSERT_NE(fifo.front(), nullptr);
+    EXPECT_EQ(*fifo.front(), 2);
+}
+
+TEST(TEST_CircularFifo, PopWithoutMove) {
+    Counted::live = 0;
+    {
+        CircularFifo<Counted, 4> fifo;
+        EXPECT_TRUE(fifo.emplace(1));
+        EXPECT_TRUE(fifo.emplace(2));
+        EXPECT_EQ(Counted::live, 2);
+
+        EXPECT_EQ(fifo.front()->value, 1);
+        EXPECT_TRUE(fifo.pop());                            // Destroyed in place, no moved-out copy
+        EXPECT_EQ(Counted::live, 1);
+        ASSERT_NE(fifo.front(), nullptr);
+        EXPECT_EQ(fifo.front()->value, 2);
+
+        EXPECT_TRUE(fifo.pop());
+        EXPECT_EQ(Counted::live, 0);
+        EXPECT_FALSE(fifo.pop());
+        EXPECT_EQ(Counted::live, 0);
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "LatestValue.hpp"
+#include <atomic>
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+struct Reading {
+    uint64_t value;
+    uint64_t copy;                                          // Equals value, unless torn
+    uint64_t inverse;                                       // Equals ~value, unless torn
+};
+
+class TEST_LatestValue : public ::testing::Test {
+protected:
+    LatestValue<Reading> mLatest;
+};
+
+TEST_F(TEST_LatestValue, ReadBeforeWrite) {
+    Reading reading{ 1, 2, 3 };
+
+    EXPECT_TRUE(mLatest.isLockFree());
+    EXPECT_EQ(mLatest.generation(), 0);
+    EXPECT_FALSE(mLatest.read(reading));
+    EXPECT_EQ(reading.value, 1);                            // Untouched
+    EXPECT_EQ(reading.copy, 2);
+    EXPECT_EQ(reading.inverse, 3);
+}
+
+TEST_F(TEST_LatestValue, WriteAndRead) {
+    Reading reading{};
+
+    mLatest.write(Reading{ 5, 5, ~5ULL });
+    EXPECT_EQ(mLatest.generation(), 1);
+    EXPECT_TRUE(mLatest.read(reading));
+    EXPECT_EQ(reading.value, 5);
+
+    EXPECT_TRUE(mLatest.read(reading));                     // Reading does not consume the value
+    EXPECT_EQ(reading.value, 5);
+    EXPECT_EQ(mLatest.generation(), 1);
+
+    mLatest.write(Reading{ 6, 6, ~6ULL });
+    mLatest.write(Reading{ 7, 7, ~7ULL });                  // Only the newest value is kept
+    EXPECT_EQ(mLatest.generation(), 3);
+    EXPECT_TRUE(mLatest.read(reading));
+    EXPECT_EQ(reading.value, 7);
+    EXPECT_EQ(reading.copy, 7);
+    EXPECT_EQ(reading.inverse, ~7ULL);
+}
+
+TEST_F(TEST_LatestValue, Clear) {
+    Reading reading{};
+
+    mLatest.write(Reading{ 1, 1, ~1ULL });
+    mLatest.write(Reading{ 2, 2, ~2ULL });
+    mLatest.clear();
+
+    EXPECT_EQ(mLatest.generation(), 0);
+    EXPECT_FALSE(mLatest.read(reading));
+
+    mLatest.write(Reading{ 3, 3, ~3ULL });                  // Usable after clear
+    EXPECT_EQ(mLatest.generation(), 1);
+    EXPECT_TRUE(mLatest.read(reading));
+    EXPECT_EQ(reading.value, 3);
+}
+
+TEST_F(TEST_LatestValue, Threading) {
+    constexpr uint64_t writes  = 1000000;
+    constexpr size_t   readers = 3;
+    std::atomic<bool> done{false};
+
+    // The writer stores its generation as value
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= writes; i++) {
+            mLatest.write(Reading{ i, i, ~i });
+        }
+        done = true;
+    });
+
+    // Every value read is untorn, values and generations never go backwards
+    std::vector<uint64_t> errors(readers, 0);
+    std::vector<uint64_t> reads(readers, 0);
+    std::vector<std::thread> threads;
+    for (size_t reader = 0; reader < readers; reader++) {
+        threads.emplace_back([&, reader]() {
+            uint64_t lastValue = 0;
+            size_t lastGeneration = 0;
+            Reading reading{};
+            while (!done) {
+                const auto generation = mLatest.generation();
+                if (generation < lastGeneration) {
+                    errors[reader]++;
+                }
+                lastGeneration = generation;
+
+                if (!mLatest.read(reading)) {
+                    continue;                               // Nothing written yet
+                }
+                if ((reading.copy != reading.value) || (reading.inverse != ~reading.value) ||
+                    (reading.value < lastValue) || (reading.value < generation)) {
+                    errors[reader]++;
+                }
+                lastValue = reading.value;
+                reads[reader]++;
+            }
+        });
+    }
+
+    writer.join();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t reader = 0; reader < readers; reader++) {
+        EXPECT_EQ(errors[reader], 0);
+    }
+
+    Reading reading{};
+    EXPECT_EQ(mLatest.generation(), writes);
+    EXPECT_TRUE(mLatest.read(reading));
+    EXPECT_EQ(reading.value, writes);
+}
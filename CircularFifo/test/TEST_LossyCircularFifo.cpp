@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "LossyCircularFifo.hpp"
+#include <atomic>
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <thread>
+
+struct Sample {
+    uint64_t value;
+    uint64_t copy;                                          // Equals value, unless torn
+    uint64_t inverse;                                       // Equals ~value, unless torn
+};
+
+class TEST_LossyCircularFifo : public ::testing::Test {
+protected:
+    LossyCircularFifo<int, 4> mFifo;
+};
+
+TEST_F(TEST_LossyCircularFifo, InitialState) {
+    int item = -1;
+
+    EXPECT_TRUE(mFifo.empty());
+    EXPECT_TRUE(mFifo.isLockFree());
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_EQ(item, -1);
+    EXPECT_EQ(mFifo.overruns(), 0);
+}
+
+TEST_F(TEST_LossyCircularFifo, PushAndPop) {
+    for (int i = 0; i < 4; i++) {
+        mFifo.push(i);                                      // Up to the capacity nothing is lost
+    }
+
+    int item = -1;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(mFifo.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_TRUE(mFifo.empty());
+    EXPECT_EQ(mFifo.overruns(), 0);
+}
+
+TEST_F(TEST_LossyCircularFifo, OverwriteOldest) {
+    for (int i = 0; i < 10; i++) {
+        mFifo.push(i);                                      // Never fails
+    }
+    EXPECT_EQ(mFifo.overruns(), 0);                         // Counted by the consumer
+
+    int item = -1;
+    for (int i = 6; i < 10; i++) {
+        EXPECT_TRUE(mFifo.pop(item));                       // The newest elements remain
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_EQ(mFifo.overruns(), 6);
+}
+
+TEST_F(TEST_LossyCircularFifo, OverwriteAfterPartialPop) {
+    int item = -1;
+    for (int i = 0; i < 3; i++) {
+        mFifo.push(i);
+    }
+    EXPECT_TRUE(mFifo.pop(item));
+    EXPECT_EQ(item, 0);
+
+    for (int i = 3; i < 8; i++) {
+        mFifo.push(i);                                      // Overwrites 1, 2 and 3
+    }
+
+    for (int i = 4; i < 8; i++) {
+        EXPECT_TRUE(mFifo.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_EQ(mFifo.overruns(), 3);
+
+    mFifo.push(8);                                          // Continues normally
+    EXPECT_TRUE(mFifo.pop(item));
+    EXPECT_EQ(item, 8);
+    EXPECT_EQ(mFifo.overruns(), 3);
+}
+
+TEST_F(TEST_LossyCircularFifo, Clear) {
+    for (int i = 0; i < 10; i++) {
+        mFifo.push(i);
+    }
+    int item = -1;
+    EXPECT_TRUE(mFifo.pop(item));
+    EXPECT_EQ(mFifo.overruns(), 6);
+
+    mFifo.clear();
+    EXPECT_TRUE(mFifo.empty());
+    EXPECT_EQ(mFifo.overruns(), 0);
+    EXPECT_FALSE(mFifo.pop(item));
+
+    mFifo.push(20);                                         // Old slots do not reappear
+    EXPECT_TRUE(mFifo.pop(item));
+    EXPECT_EQ(item, 20);
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_EQ(mFifo.overruns(), 0);
+}
+
+TEST_F(TEST_LossyCircularFifo, MultiWordElement) {
+    LossyCircularFifo<Sample, 4> fifo;
+
+    for (uint64_t i = 0; i < 6; i++) {
+        fifo.push(Sample{ i, i, ~i });
+    }
+
+    Sample sample{};
+    for (uint64_t i = 2; i < 6; i++) {
+        EXPECT_TRUE(fifo.pop(sample));
+        EXPECT_EQ(sample.value, i);
+        EXPECT_EQ(sample.copy, i);
+        EXPECT_EQ(sample.inverse, ~i);
+    }
+    EXPECT_EQ(fifo.overruns(), 2);
+}
+
+TEST_F(TEST_LossyCircularFifo, Threading) {
+    constexpr uint64_t items = 1000000;
+    LossyCircularFifo<Sample, 16> fifo;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < items; i++) {
+            fifo.push(Sample{ i, i, ~i });                  // Never waits for the consumer
+        }
+        done = true;
+    });
+
+    // Values come out strictly increasing and untorn, lost values are counted
+    uint64_t received = 0;
+    uint64_t errors   = 0;
+    uint64_t last     = 0;
+    Sample sample{};
+    for (;;) {
+        const bool finished = done;
+        if (!fifo.pop(sample)) {
+            if (finished) {
+                break;                                      // Drained after the last push
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        if ((sample.copy != sample.value) || (sample.inverse != ~sample.value) ||
+            ((received > 0) && (sample.value <= last))) {
+            errors++;
+        }
+        last = sample.value;
+        received++;
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_GT(received, 0);
+    EXPECT_EQ(last, items - 1);                             // The newest value is never lost
+    EXPECT_EQ(received + fifo.overruns(), items);           // Every element is received or counted
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "MpscCircularFifo.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class TEST_MpscCircularFifo : public ::testing::Test {
+protected:
+    MpscCircularFifo<int, 4> mFifo;
+};
+
+TEST_F(TEST_MpscCircularFifo, InitialState) {
+    int item = 0;
+
+    EXPECT_TRUE(mFifo.empty());
+    EXPECT_TRUE(mFifo.isLockFree());
+    EXPECT_FALSE(mFifo.pop(item));
+    EXPECT_FALSE(mFifo.pop());
+    EXPECT_FALSE(mFifo.peek(item));
+    EXPECT_EQ(mFifo.front(), nullptr);
+}
+
+TEST_F(TEST_MpscCircularFifo, FullAndEmpty) {
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(mFifo.push(i));
+    }
+    EXPECT_FALSE(mFifo.push(4));                            // Full, no element to distinguish full/empty
+    EXPECT_FALSE(mFifo.emplace(4));
+    EXPECT_FALSE(mFifo.empty());
+
+    int item = -1;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(mFifo.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(mFifo.pop(item));                          // Empty
+    EXPECT_EQ(item, 3);
+    EXPECT_TRUE(mFifo.empty());
+
+    EXPECT_TRUE(mFifo.push(5));                             // Space again after popping
+    EXPECT_TRUE(mFifo.peek(item));
+    EXPECT_EQ(item, 5);
+    EXPECT_FALSE(mFifo.empty());                            // Peek keeps the element
+}
+
+TEST_F(TEST_MpscCircularFifo, FrontAndPop) {
+    EXPECT_TRUE(mFifo.push(1));
+    EXPECT_TRUE(mFifo.push(2));
+
+    int* head = mFifo.front();
+    ASSERT_NE(head, nullptr);
+    EXPECT_EQ(*head, 1);
+    *head = 10;                                             // Used in place
+
+    const auto& constFifo = mFifo;
+    ASSERT_NE(constFifo.front(), nullptr);
+    EXPECT_EQ(*constFifo.front(), 10);
+
+    EXPECT_TRUE(mFifo.pop());
+    ASSERT_NE(mFifo.front(), nullptr);
+    EXPECT_EQ(*mFifo.front(), 2);
+    EXPECT_TRUE(mFifo.pop());
+
+    EXPECT_EQ(mFifo.front(), nullptr);
+    EXPECT_FALSE(mFifo.pop());
+}
+
+TEST_F(TEST_MpscCircularFifo, WrapAroundStorage) {
+    int expected = 0;
+    int next = 0;
+    for (int lap = 0; lap < 100; lap++) {
+        for (int i = 0; i < 3; i++) {
+            EXPECT_TRUE(mFifo.push(next++));
+        }
+        for (int i = 0; i < 3; i++) {
+            int item = -1;
+            EXPECT_TRUE(mFifo.pop(item));
+            EXPECT_EQ(item, expected++);
+        }
+    }
+    EXPECT_TRUE(mFifo.empty());
+}
+
+TEST_F(TEST_MpscCircularFifo, WrapAroundPositions) {
+    mFifo.SetState(std::numeric_limits<size_t>::max() - 1);   // Positions wrap to 0 after two elements
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(mFifo.push(i));
+    }
+    EXPECT_FALSE(mFifo.push(4));                            // Full across the wrap
+
+    int item = -1;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(mFifo.pop(item));
+        EXPECT_EQ(item, i);
+    }
+    EXPECT_FALSE(mFifo.pop(item));                          // Empty across the wrap
+
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(mFifo.push(lap * 4 + i));
+        }
+        for (int i = 0; i < 4; i++) {
+            EXPECT_TRUE(mFifo.pop(item));
+            EXPECT_EQ(item, lap * 4 + i);
+        }
+    }
+    EXPECT_TRUE(mFifo.empty());
+}
+
+TEST_F(TEST_MpscCircularFifo, ClearDestroysElements) {
+    MpscCircularFifo<std::shared_ptr<int>, 4> fifo;
+    auto value = std::make_shared<int>(42);
+
+    EXPECT_TRUE(fifo.push(value));
+    EXPECT_TRUE(fifo.push(value));
+    EXPECT_EQ(value.use_count(), 3);
+
+    fifo.clear();
+    EXPECT_EQ(value.use_count(), 1);
+    EXPECT_TRUE(fifo.empty());
+
+    EXPECT_TRUE(fifo.push(std::move(value)));               // Usable after clear
+    ASSERT_NE(fifo.front(), nullptr);
+    EXPECT_EQ(**fifo.front(), 42);
+}
+
+TEST_F(TEST_MpscCircularFifo, MultipleProducers) {
+    constexpr uint32_t producers = 4;
+    constexpr uint32_t items     = 100000;
+    MpscCircularFifo<uint32_t, 64> fifo;
+
+    // Each value holds the producer in the upper bits, its sequence in the lower bits
+    std::vector<std::thread> threads;
+    for (uint32_t producer = 0; producer < producers; producer++) {
+        threads.emplace_back([&fifo, producer]() {
+            for (uint32_t i = 0; i < items; i++) {
+                while (!fifo.push((producer << 24) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Per producer the values arrive in order, none are lost or duplicated
+    std::vector<uint32_t> expected(producers, 0);
+    uint32_t errors = 0;
+    for (uint32_t received = 0; received < (producers * items); ) {
+        uint32_t value = 0;
+        if (!fifo.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint32_t producer = value >> 24;
+        if ((producer >= producers) || ((value & 0xFFFFFF) != expected[producer])) {
+            errors++;
+        } else {
+            expected[producer]++;
+        }
+        received++;
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors, 0);
+    for (uint32_t producer = 0; producer < producers; producer++) {
+        EXPECT_EQ(expected[producer], items);
+    }
+    EXPECT_TRUE(fifo.empty());
+}
@@ -0,0 +1,652 @@
+/**
+ * \file BroadcastRingbuffer.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ * \class   BroadcastRingbuffer
+ *
+ * \brief   Single-Producer, Multiple-Consumer, lock free, contiguous
+ *          ringbuffer where every consumer sees every block.
+ *
+ * \details Variant of ContiguousRingbuffer with one writer and a fixed number
+ *          of independent read cursors. The writer uses 'Poke()'/'Write()',
+ *          each reader uses 'Peek()'/'Read()' with its own index. Every block
+ *          is contiguous: when a block does not fit at the end of the buffer
+ *          it is placed at the start, and the end of the data in that lap is
+ *          recorded for the readers.
+ *
+ *          By default the writer sees the free space as the minimum over all
+ *          cursors, a slow reader stalls the writer. In overrun mode the
+ *          writer never waits: a reader which is overtaken detects this in
+ *          'Read()' (the block it processed may have been overwritten), and
+ *          continues at the newest data. 'Overruns()' counts these events.
+ *
+ *          The positions count up to a multiple of the capacity, then wrap
+ *          to 0. The buffer position is the position modulo the capacity.
+ *
+ * \note    In overrun mode the writer can modify a block while a reader
+ *          processes it, only use the data after 'Read()' returned true, or
+ *          copy it first.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef BROADCAST_RING_BUFFER_HPP_
+#define BROADCAST_RING_BUFFER_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the writer and
+ *          reader administration. Override for the target if needed.
+ */
+#ifndef CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+#define CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE   64
+#endif // CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename T>
+class BroadcastRingbuffer
+{
+public:
+    BroadcastRingbuffer() noexcept;
+
+    bool Resize(const size_t size, const size_t readers, const bool overrun = false) noexcept;
+
+    bool Poke(T* &dest, size_t& size);
+    bool Write(const size_t size);
+
+    bool Peek(const size_t reader, T* &dest, size_t& size);
+    bool Read(const size_t reader, const size_t size);
+
+    size_t Size(const size_t reader) const;
+    size_t Capacity() const;
+    size_t Readers() const;
+    size_t Overruns(const size_t reader) const;
+    void Clear();
+    bool IsLockFree() const;
+
+#ifdef DEBUG
+    void SetState(size_t write, size_t read);
+    size_t Limit() const;
+#endif // DEBUG
+
+private:
+    static constexpr size_t Alignment = (CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE > alignof(std::atomic<size_t>)) ?
+                                         CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE : alignof(std::atomic<size_t>);
+
+    /**
+     * \struct  Cursor
+     * \brief   Administration of a single reader, on its own cache line.
+     */
+    struct alignas(Alignment) Cursor
+    {
+        std::atomic<size_t> read{0};                            // Owned by the reader
+        std::atomic<size_t> overruns{0};                        // Written by the reader only
+    };
+    static_assert(std::is_trivially_destructible<Cursor>::value, "Cursors are freed without destruction");
+
+    alignas(Alignment) std::atomic<size_t> mWrite{0};           // Owned by the writer
+    std::atomic<size_t> mClaim{0};                              // End of the block the writer may modify
+    std::atomic<size_t> mLapEnd[2];                             // End of the data in a lap, by lap parity
+    size_t mReadCache{0};                                       // Writer's last seen slowest read position
+
+    alignas(Alignment) size_t mCapacity{0};                     // Read-only after Resize()
+    size_t mLimit{0};                                           // Positions wrap to 0 here
+    size_t mReaders{0};
+    bool mOverrun{false};
+    std::unique_ptr<T[]> mElements;
+    std::unique_ptr<uint8_t[]> mCursorStorage;                  // Over-allocated, C++14 'new' ignores the alignment of Cursor
+    Cursor* mCursors{nullptr};                                  // Cache line aligned, in mCursorStorage
+
+    bool   Fits(const size_t write, const size_t size, const size_t used, size_t& start) const;
+    size_t SlowestRead(const size_t write) const;
+    bool   Locate(const size_t read, const size_t write, size_t& start, size_t& available) const;
+    bool   Overtaken(Cursor& cursor, const size_t read, const size_t claim);
+    inline size_t Add(const size_t position, const size_t size) const;
+    inline size_t Distance(const size_t to, const size_t from) const;
+    inline size_t LapStart(const size_t position) const;
+    inline size_t Parity(const size_t position) const;
+};
+
+
+/**
+ * \brief   Default constructor.
+ * \details Initializes the buffer with zero capacity and no readers. The
+ *          buffer must be resized using 'Resize()' before use.
+ */
+template<typename T>
+BroadcastRingbuffer<T>::BroadcastRingbuffer() noexcept :
+    mWrite(0), mClaim(0), mReadCache(0), mCapacity(0), mLimit(0), mReaders(0), mOverrun(false)
+{
+    mLapEnd[0].store(0, std::memory_order_relaxed);
+    mLapEnd[1].store(0, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Resizes the ring buffer to the specified number of elements and readers.
+ * \details Frees existing memory and allocates new memory for the buffer and
+ *          the read cursors. No extra element is needed to distinguish
+ *          between 'full' and 'empty'. Not thread safe.
+ * \param   size    The number of elements to allocate (must be greater than 0).
+ * \param   readers The number of read cursors (must be greater than 0).
+ * \param   overrun True to let the writer overrun slow readers, false to let
+ *                  slow readers stall the writer.
+ * \returns True if allocation is successful; false if size or readers is 0,
+ *          or allocation fails.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Resize(const size_t size, const size_t readers, const bool overrun) noexcept
+{
+    // Free existing memory
+    mElements.reset();
+    mCursorStorage.reset();
+    mCursors  = nullptr;
+    mCapacity = 0;
+    mReaders  = 0;
+
+    // Handle invalid size
+    if (0 == size || 0 == readers || size > (std::numeric_limits<size_t>::max() / 2) ||
+        readers > ((std::numeric_limits<size_t>::max() - Alignment) / sizeof(Cursor))) {
+        return false; // Requested size is not within valid range
+    }
+
+    // Allocate new memory
+    mElements = std::unique_ptr<T[]>(new(std::nothrow) T[size]);
+    mCursorStorage = std::unique_ptr<uint8_t[]>(new(std::nothrow) uint8_t[readers * sizeof(Cursor) + Alignment - 1]);
+    if ((nullptr == mElements) || (nullptr == mCursorStorage)) {
+        mElements.reset();
+        mCursorStorage.reset();
+        return false; // Allocation failed
+    }
+
+    // Place the cursors on a cache line boundary, so neighbouring readers do not share a line
+    const auto address = reinterpret_cast<uintptr_t>(mCursorStorage.get());
+    uint8_t* aligned   = mCursorStorage.get() + ((Alignment - (address % Alignment)) % Alignment);
+    mCursors = reinterpret_cast<Cursor*>(aligned);
+    for (size_t i = 0; i < readers; i++) {
+        new (&mCursors[i]) Cursor;                              // Trivially destructible, freed with the storage
+    }
+
+    // An even number of laps, so the lap parity continues after the positions wrap
+    mCapacity = size;
+    mLimit    = ((std::numeric_limits<size_t>::max() / size) & ~static_cast<size_t>(1)) * size;
+    mReaders  = readers;
+    mOverrun  = overrun;
+
+    Clear();
+    return true;
+}
+
+/**
+ * \brief   Checks for available contiguous space in the buffer.
+ * \details Returns a pointer to a contiguous block for writing data, either
+ *          at the current position or at the start of the buffer if the
+ *          block does not fit at the end. The user must call 'Write()' to
+ *          commit the data. In overrun mode all readers are ignored and
+ *          'size' is not changed, the block is marked as being modified so
+ *          readers can detect they are overtaken.
+ * \param   dest    Reference to a pointer that will point to the start of
+ *                  the contiguous block if found; otherwise, nullptr.
+ * \param   size    Reference to the size of the requested block; updated
+ *                  to the maximum available contiguous size if found, else 0.
+ * \returns True if a contiguous block is found; false if size is invalid
+ *          or no block is available.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Poke(T*& dest, size_t& size)
+{
+    // Handle invalid size
+    if (0 == size || size > mCapacity) {
+        dest = nullptr;
+        size = 0;
+        return false; // Size is not within valid range
+    }
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+    size_t start = 0;
+
+    if (mOverrun) {
+        Fits(write, size, 0, start);                            // Always fits
+        mClaim.store(Add(start, size), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);    // Claim is visible before the block is modified
+        dest = &mElements[start % mCapacity];
+        return true;
+    }
+
+    auto used = Distance(write, mReadCache);
+    if (!Fits(write, size, used, start)) {
+        mReadCache = SlowestRead(write);                        // Refresh the cached read position
+        used = Distance(write, mReadCache);
+
+        if (!Fits(write, size, used, start)) {
+            dest = nullptr;
+            size = 0;
+            return false;                                       // No contiguous block available
+        }
+    }
+
+    const auto free = mCapacity - used;
+    const auto to_end = mCapacity - (write % mCapacity);
+
+    size = (start == write) ? ((free < to_end) ? free : to_end) : (free - to_end);
+    dest = &mElements[start % mCapacity];
+    return true;
+}
+
+/**
+ * \brief   Advances the write position by the specified size.
+ * \details If the block does not fit at the end of the buffer, it is placed
+ *          at the start, the end of the data in the current lap is recorded
+ *          for the readers.
+ * \param   size    The number of elements to advance the write position by.
+ * \returns True if the write position was successfully advanced; false if
+ *          the size is invalid or no space is available. Returns true if
+ *          size is 0, as no update occurs.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Write(const size_t size)
+{
+    // Handle invalid size
+    if (0 == size) {
+        return true; // No update is done
+    }
+    if (size > mCapacity) {
+        return false; // Size is not within valid range
+    }
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+    size_t start = 0;
+
+    if (mOverrun) {
+        Fits(write, size, 0, start);                            // Always fits
+    } else if (!Fits(write, size, Distance(write, mReadCache), start)) {
+        mReadCache = SlowestRead(write);                        // Refresh the cached read position
+
+        if (!Fits(write, size, Distance(write, mReadCache), start)) {
+            return false;                                       // No space available
+        }
+    }
+
+    const auto next = Add(start, size);
+
+    if (start != write) {
+        mLapEnd[Parity(write)].store(write, std::memory_order_relaxed);     // Skipped the end of the lap
+    } else if (LapStart(next) != LapStart(write)) {
+        mLapEnd[Parity(write)].store(next, std::memory_order_relaxed);      // Exact fit at the end of the lap
+    }
+
+    mClaim.store(next, std::memory_order_relaxed);
+    mWrite.store(next, std::memory_order_release);
+    return true;
+}
+
+/**
+ * \brief   Checks for available filled contiguous data for a reader.
+ * \details Returns a pointer to the contiguous block of filled elements at
+ *          the reader's position. The reader must call 'Read()' to release
+ *          the data. In overrun mode an overtaken reader first continues at
+ *          the newest data.
+ * \param   reader  The index of the reader.
+ * \param   dest    Reference to a pointer that will point to the start of
+ *                  the filled contiguous block if found; otherwise, nullptr.
+ * \param   size    Reference to the size of the requested block; updated
+ *                  to the maximum available contiguous size if found, else 0.
+ * \returns True if a filled contiguous block is found; false if the reader
+ *          or size is invalid, or no block is available.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Peek(const size_t reader, T*& dest, size_t& size)
+{
+    // Handle invalid reader or size
+    if (reader >= mReaders || 0 == size || size > mCapacity) {
+        dest = nullptr;
+        size = 0;
+        return false; // Reader or size is not within valid range
+    }
+
+    Cursor& cursor = mCursors[reader];
+    auto read = cursor.read.load(std::memory_order_relaxed);
+
+    if (mOverrun && Overtaken(cursor, read, mClaim.load(std::memory_order_acquire))) {
+        read = cursor.read.load(std::memory_order_relaxed);     // Continues at the newest data
+    }
+
+    size_t start = 0;
+    size_t available = 0;
+    if (Locate(read, mWrite.load(std::memory_order_acquire), start, available) && (size <= available)) {
+        size = available;
+        dest = &mElements[start % mCapacity];
+        return true;
+    }
+
+    dest = nullptr;
+    size = 0;
+    return false; // No contiguous block available
+}
+
+/**
+ * \brief   Advances the read position of a reader by the specified size.
+ * \details In overrun mode this returns false if the writer overtook the
+ *          reader while the block was processed; the reader then continues
+ *          at the newest data and the overrun is counted.
+ * \param   reader  The index of the reader.
+ * \param   size    The number of elements to advance the read position by.
+ * \returns True if the read position was successfully advanced; false if
+ *          the reader or size is invalid, no data is available or the
+ *          reader was overtaken. Returns true if size is 0, as no update occurs.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Read(const size_t reader, const size_t size)
+{
+    // Handle invalid reader or size
+    if (reader >= mReaders || size > mCapacity) {
+        return false; // Reader or size is not within valid range
+    }
+    if (0 == size) {
+        return true; // No update is done
+    }
+
+    Cursor& cursor = mCursors[reader];
+    const auto read = cursor.read.load(std::memory_order_relaxed);
+
+    size_t start = 0;
+    size_t available = 0;
+    if (!Locate(read, mWrite.load(std::memory_order_acquire), start, available) || (size > available)) {
+        if (mOverrun) {
+            Overtaken(cursor, read, mClaim.load(std::memory_order_acquire));
+        }
+        return false; // Buffer empty, invalid size or overtaken
+    }
+
+    if (mOverrun) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);    // Block is processed before the claim is checked
+        if (Overtaken(cursor, start, mClaim.load(std::memory_order_relaxed))) {
+            return false; // Block may have been overwritten
+        }
+    }
+
+    cursor.read.store(Add(start, size), std::memory_order_release);
+    return true;
+}
+
+/**
+ * \brief   Returns the number of elements a reader has not read yet.
+ * \remark  This value is a snapshot and includes the elements skipped at
+ *          the end of a lap.
+ * \param   reader  The index of the reader.
+ * \returns The number of elements, or 0 for an invalid reader.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::Size(const size_t reader) const
+{
+    if (reader >= mReaders) {
+        return 0; // Invalid reader
+    }
+
+    const auto read  = mCursors[reader].read.load(std::memory_order_acquire);
+    const auto write = mWrite.load(std::memory_order_acquire);
+    const auto size  = Distance(write, read);
+
+    return (size > mCapacity) ? mCapacity : size;
+}
+
+/**
+ * \brief   Returns the maximum number of elements the buffer can hold.
+ * \returns The capacity of the buffer.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::Capacity() const
+{
+    return mCapacity;
+}
+
+/**
+ * \brief   Returns the number of readers.
+ * \returns The number of read cursors.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::Readers() const
+{
+    return mReaders;
+}
+
+/**
+ * \brief   Returns how often a reader was overtaken by the writer.
+ * \param   reader  The index of the reader.
+ * \returns The number of overruns, or 0 for an invalid reader.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::Overruns(const size_t reader) const
+{
+    return (reader < mReaders) ? mCursors[reader].overruns.load(std::memory_order_relaxed) : 0;
+}
+
+/**
+ * \brief   Clears the buffer.
+ * \details Resets the write position and all read cursors, effectively
+ *          emptying the buffer. Not thread safe.
+ */
+template<typename T>
+void BroadcastRingbuffer<T>::Clear()
+{
+    mWrite.store(0, std::memory_order_release);
+    mClaim.store(0, std::memory_order_release);
+    mLapEnd[0].store(0, std::memory_order_release);
+    mLapEnd[1].store(0, std::memory_order_release);
+    mReadCache = 0;
+
+    for (size_t i = 0; i < mReaders; i++) {
+        mCursors[i].read.store(0, std::memory_order_release);
+        mCursors[i].overruns.store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * \brief   Checks if the buffer's atomic operations are lock-free.
+ * \returns True if all atomic operations are lock-free; otherwise, false.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::IsLockFree() const
+{
+    return (mWrite.is_lock_free() && mClaim.is_lock_free());
+}
+
+#ifdef DEBUG
+/**
+ * \brief   Debug method to force the write position and all read cursors.
+ * \param   write   Value to set the write position to.
+ * \param   read    Value to set all read cursors to.
+ * \remarks There are no checks, so know what you are doing!
+ */
+template<typename T>
+void BroadcastRingbuffer<T>::SetState(size_t write, size_t read)
+{
+    #warning DEBUG method SetState() enabled - carefull, there be dragons here.
+
+    mWrite.store(write, std::memory_order_release);
+    mClaim.store(write, std::memory_order_release);
+    mReadCache = read;
+
+    for (size_t i = 0; i < mReaders; i++) {
+        mCursors[i].read.store(read, std::memory_order_release);
+    }
+}
+
+/**
+ * \brief   Debug method to get the position at which the positions wrap to 0.
+ * \returns The limit of the positions.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::Limit() const
+{
+    return mLimit;
+}
+#endif // DEBUG
+
+/************************************************************************/
+/* Private Members                                                      */
+/************************************************************************/
+/**
+ * \brief   Determines where a block of 'size' elements is placed.
+ * \param   write   The write position.
+ * \param   size    The size of the block.
+ * \param   used    The number of elements still needed by the slowest reader,
+ *                  0 in overrun mode.
+ * \param   start   Updated to the position of the block: the write position,
+ *                  or the start of the next lap if it does not fit at the end.
+ * \returns True if the block fits, else false.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Fits(const size_t write, const size_t size, const size_t used, size_t& start) const
+{
+    const auto to_end = mCapacity - (write % mCapacity);
+    const auto free   = mCapacity - used;
+
+    if (size <= to_end) {
+        start = write;
+        return mOverrun || (size <= free);
+    }
+
+    start = Add(write, to_end);                                 // Skip the end of the lap
+    return mOverrun || ((to_end + size) <= free);
+}
+
+/**
+ * \brief   Returns the position of the reader furthest behind the writer.
+ * \param   write   The write position.
+ * \returns The slowest read position.
+ */
+template<typename T>
+size_t BroadcastRingbuffer<T>::SlowestRead(const size_t write) const
+{
+    auto slowest = mCursors[0].read.load(std::memory_order_acquire);
+
+    for (size_t i = 1; i < mReaders; i++) {
+        const auto read = mCursors[i].read.load(std::memory_order_acquire);
+        if (Distance(write, read) > Distance(write, slowest)) {
+            slowest = read;
+        }
+    }
+    return slowest;
+}
+
+/**
+ * \brief   Locates the contiguous data at a read position.
+ * \details When the reader is at the end of the data in its lap, and the
+ *          writer continued in the next lap, the data starts at the next lap.
+ * \param   read        The read position.
+ * \param   write       The write position.
+ * \param   start       Updated to the position of the data.
+ * \param   available   Updated to the number of contiguous elements.
+ * \returns True if the positions are consistent, else false.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Locate(const size_t read, const size_t write, size_t& start, size_t& available) const
+{
+    start = read;
+
+    auto lap_start = LapStart(start);
+    auto later_lap = Distance(write, lap_start) >= mCapacity;
+    auto end = later_lap ? mLapEnd[Parity(start)].load(std::memory_order_acquire) : write;
+
+    if (later_lap && (start == end)) {
+        start = Add(lap_start, mCapacity);                      // Continue at the next lap
+        lap_start = start;
+        later_lap = Distance(write, lap_start) >= mCapacity;
+        end = later_lap ? mLapEnd[Parity(start)].load(std::memory_order_acquire) : write;
+    }
+
+    available = Distance(end, start);
+    return (available <= mCapacity);                            // Fails on an overtaken reader
+}
+
+/**
+ * \brief   Checks if the writer overtook a reader, moves the reader to the newest data if so.
+ * \param   cursor  The cursor of the reader.
+ * \param   read    The position of the data the reader accesses.
+ * \param   claim   The end of the block the writer may modify.
+ * \returns True if the reader was overtaken, else false.
+ */
+template<typename T>
+bool BroadcastRingbuffer<T>::Overtaken(Cursor& cursor, const size_t read, const size_t claim)
+{
+    if (Distance(claim, read) <= mCapacity) {
+        return false;
+    }
+
+    cursor.read.store(mWrite.load(std::memory_order_acquire), std::memory_order_release);
+    cursor.overruns.store(cursor.overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * \brief   Advances a position, wrapping to 0 at the limit.
+ * \param   position    The position.
+ * \param   size        The number of elements to advance.
+ * \returns The advanced position.
+ */
+template<typename T>
+inline size_t BroadcastRingbuffer<T>::Add(const size_t position, const size_t size) const
+{
+    return (size >= (mLimit - position)) ? (size - (mLimit - position)) : (position + size);
+}
+
+/**
+ * \brief   Returns the number of elements from one position up to another.
+ * \param   to      The position furthest ahead.
+ * \param   from    The position behind.
+ * \returns The distance, taking the wrap at the limit into account.
+ */
+template<typename T>
+inline size_t BroadcastRingbuffer<T>::Distance(const size_t to, const size_t from) const
+{
+    return (to >= from) ? (to - from) : (to + (mLimit - from));
+}
+
+/**
+ * \brief   Returns the first position of the lap a position is in.
+ * \param   position    The position.
+ * \returns The start of the lap.
+ */
+template<typename T>
+inline size_t BroadcastRingbuffer<T>::LapStart(const size_t position) const
+{
+    return position - (position % mCapacity);
+}
+
+/**
+ * \brief   Returns the parity of the lap a position is in.
+ * \param   position    The position.
+ * \returns 0 or 1, used to index the end of the data in a lap.
+ */
+template<typename T>
+inline size_t BroadcastRingbuffer<T>::Parity(const size_t position) const
+{
+    return (position / mCapacity) & 1;
+}
+
+#endif // BROADCAST_RING_BUFFER_HPP_
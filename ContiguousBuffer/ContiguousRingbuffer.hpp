@@ -24,11 +24,26 @@
  *          blocks of data. The block sizes to read and write need not be
  *          equal in size.
  *
+ *          The producer and consumer administration live on separate cache
+ *          lines. Each side caches the index of the other side, and only
+ *          reloads it when the cached value does not prove there is enough
+ *          space or data.
+ *
+ *          'Grow()' enlarges the buffer while keeping its contents, for
+ *          instance when the input rate spikes.
+ *
+ *          'ContiguousRingbufferStatisticsPolicy' collects statistics for
+ *          sizing the buffer, see 'Statistics()'. Without it the counters
+ *          are compiled out.
+ *
+ *          'ContiguousRingbuffer<T, N>' holds N elements in inline storage,
+ *          for targets which cannot allocate from the heap.
+ *
  * \note    https://github.com/tlouwers/embedded/tree/master/ContiguousBuffer
  *
  * \author  Terry Louwers (terry.louwers@fourtress.nl)
- * \version 1.5
- * \date    02-2025
+ * \version 1.12
+ * \date    10-2026
  */
 
 #ifndef CONTIGUOUS_RING_BUFFER_HPP_
@@ -38,24 +53,145 @@
  * Includes                                                                   *
  *****************************************************************************/
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../Allocation/AllocationPolicy.hpp"
 
 #ifdef DEBUG
 #include <iostream>
 #endif // DEBUG
 
 
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the producer and
+ *          consumer administration. Override for the target if needed.
+ */
+#ifndef CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+#define CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE   64
+#endif // CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Policies                                                                   *
+ *****************************************************************************/
+/**
+ * \struct  ContiguousRingbufferPolicy
+ * \brief   Default policy: no statistics.
+ */
+struct ContiguousRingbufferPolicy
+{
+    static constexpr bool Statistics = false;
+};
+
+/**
+ * \struct  ContiguousRingbufferStatisticsPolicy
+ * \brief   Statistics policy: counts the peak fill level, the failed writes
+ *          and reads, the elements skipped at the end and the distribution
+ *          of the block sizes. Each side only updates its own counters, with
+ *          relaxed atomics.
+ */
+struct ContiguousRingbufferStatisticsPolicy : ContiguousRingbufferPolicy
+{
+    static constexpr bool Statistics = true;
+};
+
+
+/******************************************************************************
+ * Types                                                                      *
+ *****************************************************************************/
+/**
+ * \struct  ContiguousRingbufferStatistics
+ * \brief   Snapshot of the statistics, requires a statistics policy.
+ * \details Block sizes are counted per power of two: bucket i holds the
+ *          blocks of 2^i up to 2^(i+1) - 1 elements, the last bucket holds
+ *          all larger blocks.
+ */
+struct ContiguousRingbufferStatistics
+{
+    static constexpr size_t Buckets = 16;
+
+    size_t peakSize{0};                                         // Highest fill level after 'Write()'
+    size_t failedWrites{0};                                     // 'Poke()' or 'Write()' returned false
+    size_t failedReads{0};                                      // 'Peek()' or 'Read()' returned false
+    size_t wrapWaste{0};                                        // Elements skipped at the end by shrinking wrap
+    size_t writeSizes[Buckets]{};                               // Blocks written, per power of two
+    size_t readSizes[Buckets]{};                                // Blocks read, per power of two
+};
+
+
+/**
+ * \brief   Smallest unsigned type holding the indices of a buffer of N
+ *          elements, which run up to N + 1. size_t for a dynamic capacity.
+ */
+template<size_t N>
+using ContiguousRingbufferIndex =
+    typename std::conditional<(N == 0),           size_t,
+    typename std::conditional<(N < UINT8_MAX),    uint8_t,
+    typename std::conditional<(N < UINT16_MAX),   uint16_t,
+    typename std::conditional<(N < UINT32_MAX),   uint32_t, size_t>::type>::type>::type>::type;
+
+
 /******************************************************************************
  * Template Class                                                             *
  *****************************************************************************/
+/**
+ * \class   ContiguousRingbufferStorage
+ * \brief   Element storage for a static capacity of N elements: inline, the
+ *          capacity is a compile time constant.
+ */
+template<typename T, size_t N>
+class ContiguousRingbufferStorage
+{
+protected:
+    static constexpr ContiguousRingbufferIndex<N> mCapacity = N + 1;    // Including the element to distinguish full/empty
+    std::array<T, N + 1> mElements{};
+};
+
+template<typename T, size_t N>
+constexpr ContiguousRingbufferIndex<N> ContiguousRingbufferStorage<T, N>::mCapacity;
+
+/**
+ * \class   ContiguousRingbufferStorage
+ * \brief   Element storage for a dynamic capacity: allocated by 'Resize()'.
+ */
 template<typename T>
-class ContiguousRingbuffer
+class ContiguousRingbufferStorage<T, 0>
+{
+protected:
+    alignas(CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE) size_t mCapacity{0};               // Read-only after Resize()
+    Region<T> mElements;
+    AllocationPolicy mPolicy{};                                 // Policy of the last Resize(), used by Grow()
+};
+
+
+/**
+ * \class   ContiguousRingbuffer
+ * \brief   With N == 0 (default) the capacity is set at runtime with
+ *          'Resize()'. With N > 0 the buffer holds N elements in inline
+ *          storage: no allocation, no 'Resize()', indices of the smallest
+ *          type holding N + 1 and a constexpr constructor, so a buffer in
+ *          static storage is initialized at compile time.
+ *          'Policy' selects the opt-in features, see the policies above.
+ */
+template<typename T, size_t N = 0, typename Policy = ContiguousRingbufferPolicy>
+class ContiguousRingbuffer : private ContiguousRingbufferStorage<T, N>
 {
 public:
-    ContiguousRingbuffer() noexcept;
+    constexpr ContiguousRingbuffer() noexcept;
 
     bool Resize(const size_t size) noexcept;
+    bool Resize(const size_t size, const AllocationPolicy& policy) noexcept;
+    bool Grow(const size_t size) noexcept;
 
     bool Poke(T* &dest, size_t& size);
     bool Write(const size_t size);
@@ -63,33 +199,83 @@ public:
     bool Peek(T* &dest, size_t& size);
     bool Read(const size_t size);
 
+    bool PokeSegments(T* &first, size_t& firstSize, T* &second, size_t& secondSize);
+    bool PeekSegments(T* &first, size_t& firstSize, T* &second, size_t& secondSize);
+
     size_t Size() const;
     size_t Capacity() const;
     void Clear();
     bool IsLockFree() const;
 
+    ContiguousRingbufferStatistics Statistics() const;
+    void ResetStatistics();
+
 #ifdef DEBUG
     void SetState(size_t write, size_t read, size_t wrap);
     bool CheckState(size_t write, size_t read, size_t wrap);
 #endif // DEBUG
 
 private:
-    std::atomic<size_t> mWrite{0};
-    std::atomic<size_t> mRead{0};
-    std::atomic<size_t> mWrap{0};
-    size_t mCapacity{0};
-    std::unique_ptr<T[]> mElements;
+    using Storage = ContiguousRingbufferStorage<T, N>;
+    using Index   = ContiguousRingbufferIndex<N>;
+    using Storage::mCapacity;
+    using Storage::mElements;
+
+    struct WriteCounters                                        // Producer's statistics, relaxed
+    {
+        std::atomic<size_t> peak{0};
+        std::atomic<size_t> failed{0};
+        std::atomic<size_t> wrapWaste{0};
+        std::atomic<size_t> sizes[ContiguousRingbufferStatistics::Buckets]{};
+    };
+    struct ReadCounters                                         // Consumer's statistics, relaxed
+    {
+        std::atomic<size_t> failed{0};
+        std::atomic<size_t> sizes[ContiguousRingbufferStatistics::Buckets]{};
+    };
+    struct NoCounters { };                                      // Statistics compiled out
+    using WriteStatistics = typename std::conditional<Policy::Statistics, WriteCounters, NoCounters>::type;
+    using ReadStatistics  = typename std::conditional<Policy::Statistics, ReadCounters, NoCounters>::type;
+
+    alignas(CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE) std::atomic<Index> mWrite{0};      // Owned by producer
+    std::atomic<Index> mWrap{0};                                // Shrunk by producer, restored by consumer
+    Index mReadCache{0};                                        // Producer's last seen read pointer
+    WriteStatistics mWriteStatistics{};
+
+    alignas(CONTIGUOUS_RINGBUFFER_CACHE_LINE_SIZE) std::atomic<Index> mRead{0};       // Owned by consumer
+    Index mWriteCache{0};                                       // Consumer's last seen write pointer
+    Index mWrapCache{0};                                        // Consumer's last seen wrap pointer
+    Index mReadShadow{0};                                       // Consumer's last known read pointer
+    ReadStatistics mReadStatistics{};
+
+    bool CanWrite(const size_t write, const size_t read, const size_t size) const;
+    bool CanRead(const size_t read, const size_t write, const size_t wrap, const size_t size) const;
+    Index Refresh(Index read, Index& write, Index& wrap);
+
+    void CountWrite(WriteCounters& counters, const size_t size, const size_t write, const size_t read, const size_t wrap, const size_t wasted = 0);
+    void CountWrite(NoCounters&, const size_t, const size_t, const size_t, const size_t, const size_t = 0) { }
+    void CountRead(ReadCounters& counters, const size_t size);
+    void CountRead(NoCounters&, const size_t) { }
+    template<typename Counters>
+    static void CountFailure(Counters& counters);
+    static void CountFailure(NoCounters&) { }
+    static void ResetCounters(WriteCounters& counters);
+    static void ResetCounters(ReadCounters& counters);
+    static void ResetCounters(NoCounters&) { }
+    static size_t Bucket(size_t size);
 };
 
 
 /**
  * \brief   Default constructor.
  * \details Initializes the buffer with zero capacity. The buffer must be
- *          resized using 'Resize()' before use.
+ *          resized using 'Resize()' before use. With a static capacity the
+ *          buffer is ready for use, in static storage without any code
+ *          running at startup.
  */
-template<typename T>
-ContiguousRingbuffer<T>::ContiguousRingbuffer() noexcept :
-    mWrite(0), mRead(0), mWrap(0), mCapacity(0)
+template<typename T, size_t N, typename Policy>
+constexpr ContiguousRingbuffer<T, N, Policy>::ContiguousRingbuffer() noexcept :
+    mWrite(0), mWrap((N > 0) ? (N + 1) : 0), mReadCache(0), mRead(0), mWriteCache(0), mWrapCache((N > 0) ? (N + 1) : 0), mReadShadow(0)
 { }
 
 /**
@@ -100,11 +286,30 @@ ContiguousRingbuffer<T>::ContiguousRingbuffer() noexcept :
  * \param   size    The number of elements to allocate (must be greater than 0).
  * \returns True if allocation is successful; false if size is 0 or allocation fails.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::Resize(const size_t size) noexcept
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Resize(const size_t size) noexcept
 {
+    static_assert(N == 0, "Resize() requires a dynamic capacity");
+
+    return Resize(size, AllocationPolicy{});
+}
+
+/**
+ * \brief   Resizes the ring buffer, allocating the elements according to 'policy'.
+ * \details As 'Resize(size)', for large buffers: the elements can be placed
+ *          on hugepages, bound to a NUMA node and pre-faulted.
+ * \param   size    The number of elements to allocate (must be greater than 0).
+ * \param   policy  How to allocate the elements, see AllocationPolicy.hpp.
+ * \returns True if allocation is successful; false if size is 0 or allocation fails.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Resize(const size_t size, const AllocationPolicy& policy) noexcept
+{
+    static_assert(N == 0, "Resize() requires a dynamic capacity");
+
     // Free existing memory
     mElements.reset();
+    this->mPolicy = policy;
 
     // Handle invalid size
     if (0 == size) {
@@ -117,12 +322,97 @@ bool ContiguousRingbuffer<T>::Resize(const size_t size) noexcept
     mWrap.store(size + 1, std::memory_order_release);
     mCapacity = size + 1;
 
+    // Reset the cached pointers
+    mReadCache  = 0;
+    mWriteCache = 0;
+    mWrapCache  = size + 1;
+    mReadShadow = 0;
+
+    ResetCounters(mWriteStatistics);
+    ResetCounters(mReadStatistics);
+
     // Allocate new memory
-    mElements = std::unique_ptr<T[]>(new(std::nothrow) T[size + 1]);
+    mElements = MakeRegion<T>(size + 1, policy);
 
     return (nullptr != mElements); // Return true if allocation was successful
 }
 
+/**
+ * \brief   Grows the ring buffer to the specified number of elements,
+ *          preserving the elements in the buffer.
+ * \details Unlike 'Resize()' the data is kept. Wrapped data is linearized:
+ *          the elements at the end of the buffer are followed by the
+ *          elements at the start. Storage mapped by the allocation policy
+ *          is enlarged with 'mremap()' for trivially copyable types, which
+ *          avoids copying unwrapped data altogether; else new storage is
+ *          allocated with the same policy and the elements are moved into
+ *          it. Not thread safe: neither producer nor consumer may access
+ *          the buffer during the call, and pointers obtained with 'Poke()'
+ *          or 'Peek()' are invalidated.
+ * \param   size    The number of elements, at least the current capacity.
+ *                  On a buffer not resized yet this acts as 'Resize()'.
+ * \returns True if the buffer was grown; false if size is smaller than the
+ *          current capacity or allocation fails. The buffer is unchanged then.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Grow(const size_t size) noexcept
+{
+    static_assert(N == 0, "Grow() requires a dynamic capacity");
+
+    // Handle buffer not resized yet
+    if (0 == mCapacity || nullptr == mElements) {
+        return Resize(size, this->mPolicy);
+    }
+
+    // Handle invalid size
+    if (size < Capacity()) {
+        return false; // Growing only, data could be lost
+    }
+
+    auto write = mWrite.load(std::memory_order_acquire);
+    auto read  = mRead.load(std::memory_order_acquire);
+    const auto wrap  = mWrap.load(std::memory_order_acquire);
+    const bool wrapped = (write < read);                        // Data at the end, up to wrap, and at the start
+    const size_t count = wrapped ? ((wrap - read) + write) : (write - read);
+
+    if (GrowRegion(mElements, size + 1, this->mPolicy)) {       // Pages remapped, contents at the same offsets
+        if (wrapped) {
+            std::rotate(&mElements[0], &mElements[0] + read, &mElements[0] + wrap);
+            read  = 0;
+            write = count;
+        }
+    } else {
+        auto elements = MakeRegion<T>(size + 1, this->mPolicy);
+        if (nullptr == elements) {
+            return false; // Allocation failed, buffer unchanged
+        }
+
+        if (wrapped) {
+            std::move(&mElements[0] + read, &mElements[0] + wrap, &elements[0]);
+            std::move(&mElements[0], &mElements[0] + write, &elements[wrap - read]);
+        } else {
+            std::move(&mElements[0] + read, &mElements[0] + write, &elements[0]);
+        }
+        mElements = std::move(elements);
+        read  = 0;
+        write = count;
+    }
+
+    // Update pointers and capacity
+    mCapacity = size + 1;
+    mWrite.store(write, std::memory_order_release);
+    mRead.store(read, std::memory_order_release);
+    mWrap.store(mCapacity, std::memory_order_release);
+
+    // Update the cached pointers
+    mReadCache  = read;
+    mWriteCache = write;
+    mWrapCache  = mCapacity;
+    mReadShadow = read;
+
+    return true;
+}
+
 /**
  * \brief   Checks for available contiguous space in the buffer.
  * \details Returns a pointer to a contiguous block for writing data,
@@ -141,18 +431,24 @@ bool ContiguousRingbuffer<T>::Resize(const size_t size) noexcept
  *          or no block is available. The 'dest' and 'size' parameters are
  *          updated accordingly.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::Poke(T*& dest, size_t& size)
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Poke(T*& dest, size_t& size)
 {
     // Handle invalid size
     if (0 == size || size >= mCapacity) {
         dest = nullptr;
         size = 0;
+        CountFailure(mWriteStatistics);
         return false; // Size is not within valid range
     }
 
     const auto write = mWrite.load(std::memory_order_relaxed);
-    const auto read  = mRead.load(std::memory_order_acquire);
+    auto read = mReadCache;
+
+    if (!CanWrite(write, read, size)) {                         // Not enough space according to cached read pointer
+        read = mRead.load(std::memory_order_acquire);
+        mReadCache = read;
+    }
 
     // Case 1: Space available at the end
     if (write >= read) {
@@ -172,9 +468,16 @@ bool ContiguousRingbuffer<T>::Poke(T*& dest, size_t& size)
             }
             // Exceptional case: buffer is empty and requested size equals read
             else if ((write == read) && (size == read)) {
-                dest = &mElements[0];
-                mRead.store(0, std::memory_order_release);      // Note: Poke() modifies mWrite and mRead!
+                // Note: Poke() modifies mWrite and mRead! A concurrent Peek() sees either the old
+                //       pointers, or wrap shrunk to read (no data), or the reset pointers.
+                const auto wrap = mWrap.load(std::memory_order_relaxed);
+                mWrap.store(read, std::memory_order_release);
                 mWrite.store(0, std::memory_order_release);
+                mRead.store(0, std::memory_order_release);
+                mWrap.store(wrap, std::memory_order_release);
+                mReadCache = 0;
+
+                dest = &mElements[0];
                 return true;
             }
         }
@@ -191,6 +494,7 @@ bool ContiguousRingbuffer<T>::Poke(T*& dest, size_t& size)
     // If none of the conditions were met, return false
     dest = nullptr;
     size = 0;
+    CountFailure(mWriteStatistics);
     return false;                                           // No contiguous block available
 }
 
@@ -206,32 +510,41 @@ bool ContiguousRingbuffer<T>::Poke(T*& dest, size_t& size)
  *          the size is invalid or no space is available. Returns true if
  *          size is 0, as no update occurs.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::Write(const size_t size)
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Write(const size_t size)
 {
     // Handle invalid size
     if (0 == size) {
         return true; // No update is done
     }
     if (size >= mCapacity) {
+        CountFailure(mWriteStatistics);
         return false; // Size is not within valid range
     }
 
     const auto write = mWrite.load(std::memory_order_relaxed);
-    const auto read  = mRead.load(std::memory_order_acquire);
+    auto read = mReadCache;
+
+    if (!CanWrite(write, read, size)) {                         // Not enough space according to cached read pointer
+        read = mRead.load(std::memory_order_acquire);
+        mReadCache = read;
+    }
 
     // Case 1: Space at the end
     if (write >= read) {
         if (write < mCapacity) {                                // Robustness, condition should always be true
             // Calculate the size available at the end, take into account the extra element when the buffer is empty
-            const size_t available = mCapacity - write - ((read > 0) ? 0 : 1);
+            const size_t end = mCapacity - write;
+            const size_t available = end - ((read > 0) ? 0 : 1);
 
             if (size <= available) {
-                if (size < (mCapacity - write)) {               // Does the requested block fit?
+                if (size < end) {                               // Does the requested block fit?
                     mWrite.store(write + size, std::memory_order_release);
+                    CountWrite(mWriteStatistics, size, write + size, read, mCapacity);
                     return true;
-                } else if (size == (mCapacity - write)) {       // Exact fit, need to wrap
+                } else if (size == end) {                       // Exact fit, need to wrap
                     mWrite.store(0, std::memory_order_release);
+                    CountWrite(mWriteStatistics, size, 0, read, mCapacity);
                     return true;
                 }
             }
@@ -239,6 +552,7 @@ bool ContiguousRingbuffer<T>::Write(const size_t size)
             if (size < read) {
                 mWrap.store(write, std::memory_order_release);  // Shrink wrap to prevent claiming memory at the end
                 mWrite.store(size, std::memory_order_release);
+                CountWrite(mWriteStatistics, size, size, read, write, mCapacity - write);
                 return true;
             }
         }
@@ -246,9 +560,11 @@ bool ContiguousRingbuffer<T>::Write(const size_t size)
     // Case 3: Space at the start when write < read
     else if ((write + size) < read) {
         mWrite.store(write + size, std::memory_order_release);
+        CountWrite(mWriteStatistics, size, write + size, read, mWrap.load(std::memory_order_relaxed));
         return true;
     }
 
+    CountFailure(mWriteStatistics);
     return false;                                               // No space available
 }
 
@@ -268,18 +584,24 @@ bool ContiguousRingbuffer<T>::Write(const size_t size)
  *          invalid or no block is available. The 'dest' and 'size'
  *          parameters are updated accordingly.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::Peek(T*& dest, size_t& size)
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Peek(T*& dest, size_t& size)
 {
     // Handle invalid size
     if (0 == size || size >= mCapacity) {
         dest = nullptr;
         size = 0;
+        CountFailure(mReadStatistics);
         return false; // Size is not within valid range
     }
 
-    const auto read  = mRead.load(std::memory_order_relaxed);
-    const auto write = mWrite.load(std::memory_order_acquire);
+    auto read  = mRead.load(std::memory_order_acquire);
+    auto write = mWriteCache;
+    auto wrap  = mWrapCache;
+
+    if ((read != mReadShadow) || !CanRead(read, write, wrap, size)) {   // Reset by Poke(), or not enough data according to cache
+        read = Refresh(read, write, wrap);
+    }
 
     // Case 1: Data available at the start
     if (write >= read) {
@@ -292,8 +614,6 @@ bool ContiguousRingbuffer<T>::Peek(T*& dest, size_t& size)
     // Case 2: Data available at the end
     else { // write < read
         if (read < mCapacity) {                                 // Robustness, condition should always be true
-            const auto wrap = mWrap.load(std::memory_order_acquire);
-
             if ((read + size) <= wrap) {                        // Requested size available?
                 size = wrap - read;
                 dest = &mElements[read];
@@ -314,6 +634,7 @@ bool ContiguousRingbuffer<T>::Peek(T*& dest, size_t& size)
     // If none of the conditions were met, return false
     dest = nullptr;
     size = 0;
+    CountFailure(mReadStatistics);
     return false;                                               // No contiguous block available
 }
 
@@ -329,48 +650,63 @@ bool ContiguousRingbuffer<T>::Peek(T*& dest, size_t& size)
  *          the size is invalid or no data is available. Returns true if
  *          size is 0, as no update occurs.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::Read(const size_t size)
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::Read(const size_t size)
 {
     // Handle invalid size
     if (0 == size) {
         return true; // No update is done
     }
     if (size >= mCapacity) {
+        CountFailure(mReadStatistics);
         return false; // Size is not within valid range
     }
 
-    const auto read  = mRead.load(std::memory_order_relaxed);
-    const auto write = mWrite.load(std::memory_order_acquire);
+    auto read  = mRead.load(std::memory_order_acquire);
+    auto write = mWriteCache;
+    auto wrap  = mWrapCache;
+
+    if ((read != mReadShadow) || !CanRead(read, write, wrap, size)) {   // Reset by Poke(), or not enough data according to cache
+        read = Refresh(read, write, wrap);
+    }
+
     const auto read_and_size = read + size;
 
     // Case 1: Data available at the start
     if (read < write) {
         if (read_and_size <= write) {                           // Requested size available?
+            mReadShadow = read_and_size;
             mRead.store(read_and_size, std::memory_order_release);
+            CountRead(mReadStatistics, size);
             return true;
         }
     }
     // Case 2: Data available at the end
     else if (read > write) {
         if (read < mCapacity) {                                 // Robustness, condition should always be true
-            const auto wrap = mWrap.load(std::memory_order_acquire);
-
             if (read_and_size < wrap) {                         // Requested size available? And we do not wrap?
+                mReadShadow = read_and_size;
                 mRead.store(read_and_size, std::memory_order_release);
+                CountRead(mReadStatistics, size);
                 return true;
             }
             else if (read_and_size == wrap) {                   // Requested size available? And we do wrap?
+                mWrapCache  = mCapacity;
+                mReadShadow = 0;
                 mWrap.store(mCapacity, std::memory_order_release);
                 mRead.store(0, std::memory_order_release);
+                CountRead(mReadStatistics, size);
                 return true;
             }
             // Exception: when read/write were equal at the end of the buffer and a large block was written,
             //            this resulted in wrap being shrunk and becoming equal to read.
             else if (read == wrap) {                            // Data available at the start?
                 if (size <= write) {                            // Requested size available?
+                    mWrapCache  = mCapacity;
+                    mReadShadow = size;
                     mWrap.store(mCapacity, std::memory_order_release);
                     mRead.store(size, std::memory_order_release);
+                    CountRead(mReadStatistics, size);
                     return true;
                 }
             }
@@ -378,9 +714,102 @@ bool ContiguousRingbuffer<T>::Read(const size_t size)
     }
 
     // If none of the conditions were met, return false
+    CountFailure(mReadStatistics);
     return false;                                               // Buffer empty or invalid size
 }
 
+/**
+ * \brief   Returns all free space in the buffer as up to two contiguous segments.
+ * \details Intended for scatter I/O (i.e. 'readv()'): the first segment runs
+ *          up to the end of the buffer, the second starts at the beginning.
+ *          Commit the elements written with 'Write()': first with the number
+ *          of elements in the first segment (at most 'firstSize'), then with
+ *          the remainder in the second segment.
+ * \param   first       Updated to the start of the first segment, else nullptr.
+ * \param   firstSize   Updated to the size of the first segment, else 0.
+ * \param   second      Updated to the start of the second segment, else nullptr.
+ * \param   secondSize  Updated to the size of the second segment, else 0.
+ * \returns True if there is free space; false if the buffer is full or not resized.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::PokeSegments(T*& first, size_t& firstSize, T*& second, size_t& secondSize)
+{
+    first = nullptr;
+    firstSize = 0;
+    second = nullptr;
+    secondSize = 0;
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+    const auto read  = mRead.load(std::memory_order_acquire);
+    mReadCache = read;
+
+    // Case 1: Space at the end, and at the start when read is not at the start
+    if (write >= read) {
+        if (write < mCapacity) {                                // Robustness check
+            firstSize  = mCapacity - write - ((read > 0) ? 0 : 1);
+            secondSize = (read > 0) ? (read - 1) : 0;
+        }
+    }
+    // Case 2: Space between write and read
+    else { // write < read
+        firstSize = read - write - 1;
+    }
+
+    if (firstSize > 0) {
+        first = &mElements[write];
+    }
+    if (secondSize > 0) {
+        second = &mElements[0];
+    }
+    return (firstSize + secondSize) > 0;
+}
+
+/**
+ * \brief   Returns all data in the buffer as up to two contiguous segments.
+ * \details Intended for gather I/O (i.e. 'writev()'): the first segment runs
+ *          up to the wrap pointer, the second starts at the beginning. Release
+ *          the elements processed with 'Read()': first with the number of
+ *          elements in the first segment (at most 'firstSize'), then with the
+ *          remainder in the second segment.
+ * \param   first       Updated to the start of the first segment, else nullptr.
+ * \param   firstSize   Updated to the size of the first segment, else 0.
+ * \param   second      Updated to the start of the second segment, else nullptr.
+ * \param   secondSize  Updated to the size of the second segment, else 0.
+ * \returns True if there is data; false if the buffer is empty or not resized.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::PeekSegments(T*& first, size_t& firstSize, T*& second, size_t& secondSize)
+{
+    first = nullptr;
+    firstSize = 0;
+    second = nullptr;
+    secondSize = 0;
+
+    Index write = 0;
+    Index wrap  = 0;
+    const auto read = Refresh(mRead.load(std::memory_order_acquire), write, wrap);
+
+    // Case 1: Data between read and write
+    if (write >= read) {
+        firstSize = write - read;
+    }
+    // Case 2: Data up to wrap, and at the start
+    else { // write < read
+        if (read < mCapacity) {                                 // Robustness, condition should always be true
+            firstSize  = (wrap > read) ? (wrap - read) : 0;     // Empty when wrap was shrunk to read
+            secondSize = write;
+        }
+    }
+
+    if (firstSize > 0) {
+        first = &mElements[read];
+    }
+    if (secondSize > 0) {
+        second = &mElements[0];
+    }
+    return (firstSize + secondSize) > 0;
+}
+
 /**
  * \brief   Returns the number of elements currently in the buffer.
  * \remark  This value is a snapshot and may be slightly inaccurate due to
@@ -388,8 +817,8 @@ bool ContiguousRingbuffer<T>::Read(const size_t size)
  * \returns The total number of elements in the buffer, or 0 if the buffer
  *          is empty or not resized.
  */
-template<typename T>
-size_t ContiguousRingbuffer<T>::Size() const
+template<typename T, size_t N, typename Policy>
+size_t ContiguousRingbuffer<T, N, Policy>::Size() const
 {
     if (0 == mCapacity) {
         return 0; // Buffer not resized yet
@@ -426,8 +855,8 @@ size_t ContiguousRingbuffer<T>::Size() const
  * \returns The maximum capacity of the buffer, accounting for the extra
  *          element used to distinguish between 'full' and 'empty' states.
  */
-template<typename T>
-size_t ContiguousRingbuffer<T>::Capacity() const
+template<typename T, size_t N, typename Policy>
+size_t ContiguousRingbuffer<T, N, Policy>::Capacity() const
 {
     return mCapacity - 1;
 }
@@ -437,24 +866,68 @@ size_t ContiguousRingbuffer<T>::Capacity() const
  * \details Resets the write, read, and wrap pointers to their initial states,
  *          effectively emptying the buffer.
  */
-template<typename T>
-void ContiguousRingbuffer<T>::Clear()
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::Clear()
 {
     mWrite.store(0, std::memory_order_release);
     mRead.store(0, std::memory_order_release);
     mWrap.store(mCapacity, std::memory_order_release);
+
+    mReadCache  = 0;
+    mWriteCache = 0;
+    mWrapCache  = mCapacity;
+    mReadShadow = 0;
 }
 
 /**
  * \brief   Checks if the buffer's atomic operations are lock-free.
  * \returns True if all atomic operations are lock-free; otherwise, false.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::IsLockFree() const
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::IsLockFree() const
 {
     return (mWrite.is_lock_free() && mRead.is_lock_free() && mWrap.is_lock_free());
 }
 
+/**
+ * \brief   Returns a snapshot of the statistics, requires a statistics policy.
+ * \details Each counter is updated by one side only, with relaxed atomics,
+ *          so counting adds no contention. The snapshot may be taken from any
+ *          thread, the counters are not mutually consistent then. The peak
+ *          fill level is calculated by the producer after 'Write()', the read
+ *          pointer is only loaded when the cached one indicates a new peak.
+ * \returns The statistics since the last 'Resize()' or 'ResetStatistics()'.
+ */
+template<typename T, size_t N, typename Policy>
+ContiguousRingbufferStatistics ContiguousRingbuffer<T, N, Policy>::Statistics() const
+{
+    static_assert(Policy::Statistics, "Statistics() requires a statistics policy");
+
+    ContiguousRingbufferStatistics statistics;
+
+    statistics.peakSize     = mWriteStatistics.peak.load(std::memory_order_relaxed);
+    statistics.failedWrites = mWriteStatistics.failed.load(std::memory_order_relaxed);
+    statistics.failedReads  = mReadStatistics.failed.load(std::memory_order_relaxed);
+    statistics.wrapWaste    = mWriteStatistics.wrapWaste.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < ContiguousRingbufferStatistics::Buckets; i++) {
+        statistics.writeSizes[i] = mWriteStatistics.sizes[i].load(std::memory_order_relaxed);
+        statistics.readSizes[i]  = mReadStatistics.sizes[i].load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+/**
+ * \brief   Resets the statistics, requires a statistics policy. Not thread safe.
+ */
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::ResetStatistics()
+{
+    static_assert(Policy::Statistics, "ResetStatistics() requires a statistics policy");
+
+    ResetCounters(mWriteStatistics);
+    ResetCounters(mReadStatistics);
+}
+
 #ifdef DEBUG
 /**
  * \brief   Debug method to force a state to be set to the mWrite/mRead/mWrap
@@ -464,14 +937,19 @@ bool ContiguousRingbuffer<T>::IsLockFree() const
  * \param   wrap    Value to set mWrap to.
  * \remarks There are no checks, so know what you are doing!
  */
-template<typename T>
-void ContiguousRingbuffer<T>::SetState(size_t write, size_t read, size_t wrap)
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::SetState(size_t write, size_t read, size_t wrap)
 {
     #warning DEBUG method SetState() enabled - carefull, there be dragons here.
 
     mWrite.store(write, std::memory_order_release);
     mRead.store(read, std::memory_order_release);
     mWrap.store(wrap, std::memory_order_release);
+
+    mReadCache  = read;
+    mWriteCache = write;
+    mWrapCache  = wrap;
+    mReadShadow = read;
 }
 
 /**
@@ -481,8 +959,8 @@ void ContiguousRingbuffer<T>::SetState(size_t write, size_t read, size_t wrap)
  * \param   wrap    Value to check mWrap against.
  * \returns True if the state matches, else false.
  */
-template<typename T>
-bool ContiguousRingbuffer<T>::CheckState(size_t write, size_t read, size_t wrap)
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::CheckState(size_t write, size_t read, size_t wrap)
 {
     #warning DEBUG method CheckState() enabled.
 
@@ -496,4 +974,179 @@ bool ContiguousRingbuffer<T>::CheckState(size_t write, size_t read, size_t wrap)
 }
 #endif // DEBUG
 
+/************************************************************************/
+/* Private Members                                                      */
+/************************************************************************/
+/**
+ * \brief   Checks if a block of 'size' elements can be written.
+ * \details Same conditions as 'Poke()' and 'Write()', used to decide if the
+ *          cached read pointer suffices. A stale read pointer only
+ *          underestimates the free space.
+ * \param   write   The write pointer.
+ * \param   read    The (cached) read pointer.
+ * \param   size    The size of the block.
+ * \returns True if the block fits, else false.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::CanWrite(const size_t write, const size_t read, const size_t size) const
+{
+    if (write >= read) {
+        return (write < mCapacity) &&
+               ((size <= (mCapacity - write - ((read > 0) ? 0 : 1))) || (size < read));
+    }
+    return ((write + size) < read);
+}
+
+/**
+ * \brief   Checks if a block of 'size' elements can be read.
+ * \details Same conditions as 'Peek()' and 'Read()', used to decide if the
+ *          cached write and wrap pointers suffice. Stale pointers only
+ *          underestimate the available data.
+ * \param   read    The read pointer.
+ * \param   write   The (cached) write pointer.
+ * \param   wrap    The (cached) wrap pointer.
+ * \param   size    The size of the block.
+ * \returns True if the data is available, else false.
+ */
+template<typename T, size_t N, typename Policy>
+bool ContiguousRingbuffer<T, N, Policy>::CanRead(const size_t read, const size_t write, const size_t wrap, const size_t size) const
+{
+    if (write >= read) {
+        return ((read + size) <= write);
+    }
+    return (read < mCapacity) &&
+           (((read + size) <= wrap) || ((read == wrap) && (size <= write)));
+}
+
+/**
+ * \brief   Reloads the write and wrap pointers for the consumer.
+ * \details The write and wrap pointers are loaded together. If 'Poke()'
+ *          reset the pointers meanwhile, the read pointer changed: load
+ *          again. Updates the consumer's cached pointers.
+ * \param   read    The read pointer.
+ * \param   write   Updated to the write pointer.
+ * \param   wrap    Updated to the wrap pointer.
+ * \returns The read pointer matching the write and wrap pointers.
+ */
+template<typename T, size_t N, typename Policy>
+typename ContiguousRingbuffer<T, N, Policy>::Index ContiguousRingbuffer<T, N, Policy>::Refresh(Index read, Index& write, Index& wrap)
+{
+    for (;;) {
+        write = mWrite.load(std::memory_order_acquire);
+        wrap  = mWrap.load(std::memory_order_acquire);
+
+        const auto current = mRead.load(std::memory_order_acquire);
+        if (current == read) {
+            break;
+        }
+        read = current;                                         // Reset by Poke(), load again
+    }
+
+    mWriteCache = write;
+    mWrapCache  = wrap;
+    mReadShadow = read;
+    return read;
+}
+
+/**
+ * \brief   Counts a block written by the producer.
+ * \details Updates the block size distribution, the peak fill level and the
+ *          elements skipped at the end. A new peak according to the cached
+ *          read pointer is confirmed with the current read pointer, which
+ *          refreshes the cache. Compiled out without statistics.
+ * \param   counters    The producer's counters.
+ * \param   size        The size of the block.
+ * \param   write       The write pointer after the block.
+ * \param   read        The (cached) read pointer.
+ * \param   wrap        The wrap pointer after the block.
+ * \param   wasted      The elements skipped at the end by shrinking wrap.
+ */
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::CountWrite(WriteCounters& counters, const size_t size, const size_t write, const size_t read, const size_t wrap, const size_t wasted)
+{
+    auto used = (write >= read) ? (write - read) : ((wrap - read) + write);
+    if (used > counters.peak.load(std::memory_order_relaxed)) { // A stale read pointer overestimates, confirm
+        const auto current = mRead.load(std::memory_order_acquire);
+        mReadCache = current;
+
+        used = (write >= current) ? (write - current) : ((wrap - current) + write);
+        if (used > counters.peak.load(std::memory_order_relaxed)) {
+            counters.peak.store(used, std::memory_order_relaxed);
+        }
+    }
+    if (wasted > 0) {
+        counters.wrapWaste.store(counters.wrapWaste.load(std::memory_order_relaxed) + wasted, std::memory_order_relaxed);
+    }
+    auto& bucket = counters.sizes[Bucket(size)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Counts a block read by the consumer. Compiled out without statistics.
+ * \param   counters    The consumer's counters.
+ * \param   size        The size of the block.
+ */
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::CountRead(ReadCounters& counters, const size_t size)
+{
+    auto& bucket = counters.sizes[Bucket(size)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Counts a failed 'Poke()'/'Write()' or 'Peek()'/'Read()'. Compiled
+ *          out without statistics.
+ * \param   counters    The counters of the side which failed.
+ */
+template<typename T, size_t N, typename Policy>
+template<typename Counters>
+void ContiguousRingbuffer<T, N, Policy>::CountFailure(Counters& counters)
+{
+    counters.failed.store(counters.failed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Resets the producer's counters. Compiled out without statistics.
+ * \param   counters    The producer's counters.
+ */
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::ResetCounters(WriteCounters& counters)
+{
+    counters.peak.store(0, std::memory_order_relaxed);
+    counters.failed.store(0, std::memory_order_relaxed);
+    counters.wrapWaste.store(0, std::memory_order_relaxed);
+    for (auto& bucket : counters.sizes) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * \brief   Resets the consumer's counters. Compiled out without statistics.
+ * \param   counters    The consumer's counters.
+ */
+template<typename T, size_t N, typename Policy>
+void ContiguousRingbuffer<T, N, Policy>::ResetCounters(ReadCounters& counters)
+{
+    counters.failed.store(0, std::memory_order_relaxed);
+    for (auto& bucket : counters.sizes) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * \brief   Returns the bucket of the block size distribution for 'size'.
+ * \param   size    The size of the block, greater than 0.
+ * \returns The power of two of the size, limited to the last bucket.
+ */
+template<typename T, size_t N, typename Policy>
+size_t ContiguousRingbuffer<T, N, Policy>::Bucket(size_t size)
+{
+    size_t bucket = 0;
+    while ((size > 1) && (bucket < (ContiguousRingbufferStatistics::Buckets - 1))) {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
 #endif // CONTIGUOUS_RING_BUFFER_HPP_
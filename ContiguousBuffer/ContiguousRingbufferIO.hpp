@@ -0,0 +1,125 @@
+/**
+ * \file ContiguousRingbufferIO.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ *
+ * \brief   Scatter-gather I/O between a ContiguousRingbuffer and a file
+ *          descriptor (socket, pipe, file). POSIX only.
+ *
+ * \details 'FillFromFd()' reads into all free space of the buffer with a
+ *          single 'readv()', 'DrainToFd()' writes all data in the buffer with
+ *          a single 'writev()'. Both respect the wrap pointer and commit only
+ *          the number of bytes actually transferred, so a short read or write
+ *          leaves the buffer consistent. The producer side ('FillFromFd()')
+ *          and consumer side ('DrainToFd()') may run in different threads.
+ *
+ * \note    Byte sized elements only, a partial element cannot be committed.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef CONTIGUOUS_RING_BUFFER_IO_HPP_
+#define CONTIGUOUS_RING_BUFFER_IO_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <cerrno>
+#include <cstddef>
+#include <algorithm>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "ContiguousRingbuffer.hpp"
+
+
+/******************************************************************************
+ * Functions                                                                  *
+ *****************************************************************************/
+/**
+ * \brief   Reads from 'fd' into the free space of the buffer with a single 'readv()'.
+ * \details Acts as the producer of the buffer. The bytes read are committed
+ *          with 'Write()', split over the end and the start of the buffer.
+ * \param   buffer  The buffer to fill.
+ * \param   fd      The file descriptor to read from.
+ * \returns The number of bytes read, 0 at end of file, or -1 on error with
+ *          errno set by 'readv()'. Returns -1 with errno ENOBUFS if the buffer
+ *          is full, no system call is made then.
+ */
+template<typename T, size_t N, typename Policy>
+ssize_t FillFromFd(ContiguousRingbuffer<T, N, Policy>& buffer, const int fd)
+{
+    static_assert(sizeof(T) == 1, "Scatter-gather I/O requires byte sized elements");
+
+    T* first = nullptr;
+    T* second = nullptr;
+    size_t firstSize = 0;
+    size_t secondSize = 0;
+
+    if (!buffer.PokeSegments(first, firstSize, second, secondSize)) {
+        errno = ENOBUFS;
+        return -1; // Buffer full
+    }
+
+    struct iovec segments[2] = { { first, firstSize }, { second, secondSize } };
+    const ssize_t result = readv(fd, segments, (secondSize > 0) ? 2 : 1);
+
+    if (result > 0) {
+        const size_t transferred = static_cast<size_t>(result);
+        const size_t inFirst = std::min(transferred, firstSize);
+
+        buffer.Write(inFirst);                                  // Up to the end, may wrap
+        buffer.Write(transferred - inFirst);                    // Remainder at the start
+    }
+    return result;
+}
+
+/**
+ * \brief   Writes the data in the buffer to 'fd' with a single 'writev()'.
+ * \details Acts as the consumer of the buffer. The bytes written are released
+ *          with 'Read()', split over the end and the start of the buffer.
+ * \param   buffer  The buffer to drain.
+ * \param   fd      The file descriptor to write to.
+ * \returns The number of bytes written, 0 if the buffer is empty (no system
+ *          call is made), or -1 on error with errno set by 'writev()'.
+ */
+template<typename T, size_t N, typename Policy>
+ssize_t DrainToFd(ContiguousRingbuffer<T, N, Policy>& buffer, const int fd)
+{
+    static_assert(sizeof(T) == 1, "Scatter-gather I/O requires byte sized elements");
+
+    T* first = nullptr;
+    T* second = nullptr;
+    size_t firstSize = 0;
+    size_t secondSize = 0;
+
+    if (!buffer.PeekSegments(first, firstSize, second, secondSize)) {
+        return 0; // Buffer empty
+    }
+
+    // Skip an empty first segment, when the wrap pointer was shrunk to read
+    struct iovec segments[2] = { { first, firstSize }, { second, secondSize } };
+    struct iovec* start = (firstSize > 0) ? &segments[0] : &segments[1];
+    const int count = ((firstSize > 0) ? 1 : 0) + ((secondSize > 0) ? 1 : 0);
+
+    const ssize_t result = writev(fd, start, count);
+
+    if (result > 0) {
+        const size_t transferred = static_cast<size_t>(result);
+        const size_t inFirst = std::min(transferred, firstSize);
+
+        buffer.Read(inFirst);                                   // Up to wrap, may wrap
+        buffer.Read(transferred - inFirst);                     // Remainder at the start
+    }
+    return result;
+}
+
+#endif // CONTIGUOUS_RING_BUFFER_IO_HPP_
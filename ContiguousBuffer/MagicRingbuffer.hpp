@@ -0,0 +1,411 @@
+/**
+ * \file MagicRingbuffer.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ * \class   MagicRingbuffer
+ *
+ * \brief   Single-Producer, Single-Consumer, lock free, wait free, contiguous
+ *          ringbuffer using a double mapped memory region ("magic ring
+ *          buffer"). Linux only.
+ *
+ * \details Alternative to ContiguousRingbuffer with the same 'Poke()',
+ *          'Write()', 'Peek()' and 'Read()' interface. The same physical
+ *          pages are mapped twice, back to back, so a block starting near
+ *          the end of the buffer continues in the second mapping: every
+ *          block is contiguous by construction. There is no wrap index, no
+ *          elements are left unused at the end and the full capacity is
+ *          available to every 'Poke()' and 'Peek()'.
+ *
+ *          The indices are free running, the position in the buffer is the
+ *          index modulo the capacity. The capacity is rounded up so the buffer
+ *          spans a whole number of pages.
+ *
+ * \note    Only trivially copyable element types, the elements are not
+ *          constructed. 'Resize()' costs several system calls.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.0
+ * \date    10-2026
+ */
+
+#ifndef MAGIC_RING_BUFFER_HPP_
+#define MAGIC_RING_BUFFER_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef DEBUG
+#include <iostream>
+#endif // DEBUG
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename T>
+class MagicRingbuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Elements in mapped memory must be trivially copyable");
+
+public:
+    MagicRingbuffer() noexcept;
+    ~MagicRingbuffer();
+
+    MagicRingbuffer(const MagicRingbuffer&) = delete;
+    MagicRingbuffer& operator=(const MagicRingbuffer&) = delete;
+
+    bool Resize(const size_t size) noexcept;
+
+    bool Poke(T* &dest, size_t& size);
+    bool Write(const size_t size);
+
+    bool Peek(T* &dest, size_t& size);
+    bool Read(const size_t size);
+
+    size_t Size() const;
+    size_t Capacity() const;
+    void Clear();
+    bool IsLockFree() const;
+
+#ifdef DEBUG
+    void SetState(size_t write, size_t read);
+    bool CheckState(size_t write, size_t read);
+#endif // DEBUG
+
+private:
+    std::atomic<size_t> mWrite{0};
+    std::atomic<size_t> mRead{0};
+    size_t mCapacity{0};
+    size_t mBytes{0};
+    T* mElements{nullptr};
+
+    void Unmap();
+};
+
+
+/**
+ * \brief   Default constructor.
+ * \details Initializes the buffer with zero capacity. The buffer must be
+ *          resized using 'Resize()' before use.
+ */
+template<typename T>
+MagicRingbuffer<T>::MagicRingbuffer() noexcept :
+    mWrite(0), mRead(0), mCapacity(0), mBytes(0), mElements(nullptr)
+{ }
+
+/**
+ * \brief   Destructor, unmaps the buffer.
+ */
+template<typename T>
+MagicRingbuffer<T>::~MagicRingbuffer()
+{
+    Unmap();
+}
+
+/**
+ * \brief   Resizes the ring buffer to at least the specified number of elements.
+ * \details Frees the existing mapping, creates an anonymous memory file and
+ *          maps it twice, back to back. The size is rounded up to a whole
+ *          number of pages, use 'Capacity()' for the actual size. No extra
+ *          element is needed to distinguish between 'full' and 'empty'.
+ * \param   size    The number of elements to allocate (must be greater than 0).
+ * \returns True if mapping is successful; false if size is 0 or mapping fails.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::Resize(const size_t size) noexcept
+{
+    // Free existing mapping
+    Unmap();
+
+    // Handle invalid size
+    if (0 == size) {
+        return false; // Requested size is zero
+    }
+
+    // Round up to the smallest number of elements spanning whole pages
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t unit = page;
+    while ((unit % sizeof(T)) != 0) {
+        unit += page;
+    }
+    const size_t bytes = ((size * sizeof(T) + unit - 1) / unit) * unit;
+
+    const int fd = memfd_create("MagicRingbuffer", MFD_CLOEXEC);
+    if (fd < 0) {
+        return false; // No anonymous memory file
+    }
+
+    // Reserve address space for both mappings, then map the file twice into it
+    uint8_t* base = nullptr;
+    void* reserved = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(bytes)) == 0) {
+        reserved = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (reserved != MAP_FAILED) {
+        base = static_cast<uint8_t*>(reserved);
+        if ((mmap(base,         bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) ||
+            (mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)) {
+            munmap(base, 2 * bytes);
+            base = nullptr;
+        }
+    }
+    close(fd); // The mappings keep the memory alive
+
+    if (nullptr == base) {
+        return false; // Mapping failed
+    }
+
+    // Reset pointers and update capacity
+    mWrite.store(0, std::memory_order_release);
+    mRead.store(0, std::memory_order_release);
+    mCapacity = bytes / sizeof(T);
+    mBytes    = bytes;
+    mElements = reinterpret_cast<T*>(base);
+
+    return true;
+}
+
+/**
+ * \brief   Checks for available contiguous space in the buffer.
+ * \details Returns a pointer to a contiguous block for writing data. All free
+ *          space is contiguous, so the block is never shorter than the free
+ *          space. The user must call 'Write()' to commit the data.
+ * \param   dest    Reference to a pointer that will point to the start of
+ *                  the contiguous block if found; otherwise, nullptr.
+ * \param   size    Reference to the size of the requested block; updated
+ *                  to the free space if found, else 0.
+ * \returns True if a contiguous block is found; false if size is invalid
+ *          or not enough space is available. The 'dest' and 'size'
+ *          parameters are updated accordingly.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::Poke(T*& dest, size_t& size)
+{
+    // Handle invalid size
+    if (0 == size || size > mCapacity) {
+        dest = nullptr;
+        size = 0;
+        return false; // Size is not within valid range
+    }
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+    const auto read  = mRead.load(std::memory_order_acquire);
+    const auto available = mCapacity - (write - read);
+
+    if (size <= available) {                                    // Does the requested block fit?
+        size = available;
+        dest = &mElements[write % mCapacity];                   // May continue into the second mapping
+        return true;
+    }
+
+    dest = nullptr;
+    size = 0;
+    return false;                                               // No contiguous block available
+}
+
+/**
+ * \brief   Advances the write pointer by the specified size.
+ * \param   size    The number of elements to advance the write pointer by.
+ * \returns True if the write pointer was successfully advanced; false if
+ *          the size is invalid or no space is available. Returns true if
+ *          size is 0, as no update occurs.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::Write(const size_t size)
+{
+    // Handle invalid size
+    if (0 == size) {
+        return true; // No update is done
+    }
+    if (size > mCapacity) {
+        return false; // Size is not within valid range
+    }
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+    const auto read  = mRead.load(std::memory_order_acquire);
+
+    if (size <= mCapacity - (write - read)) {                   // Enough space?
+        mWrite.store(write + size, std::memory_order_release);
+        return true;
+    }
+
+    return false;                                               // No space available
+}
+
+/**
+ * \brief   Checks for available filled contiguous data in the buffer.
+ * \details Returns a pointer to a contiguous block of filled elements. All
+ *          elements are contiguous, so the block holds every element in the
+ *          buffer. The user must call 'Read()' to release the data.
+ * \param   dest    Reference to a pointer that will point to the start of
+ *                  the filled contiguous block if found; otherwise, nullptr.
+ * \param   size    Reference to the size of the requested block; updated
+ *                  to the number of elements if found, else 0.
+ * \returns True if a filled contiguous block is found; false if size is
+ *          invalid or not enough data is available. The 'dest' and 'size'
+ *          parameters are updated accordingly.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::Peek(T*& dest, size_t& size)
+{
+    // Handle invalid size
+    if (0 == size || size > mCapacity) {
+        dest = nullptr;
+        size = 0;
+        return false; // Size is not within valid range
+    }
+
+    const auto read  = mRead.load(std::memory_order_relaxed);
+    const auto write = mWrite.load(std::memory_order_acquire);
+    const auto available = write - read;
+
+    if (size <= available) {                                    // Requested size available?
+        size = available;
+        dest = &mElements[read % mCapacity];                    // May continue into the second mapping
+        return true;
+    }
+
+    dest = nullptr;
+    size = 0;
+    return false;                                               // No contiguous block available
+}
+
+/**
+ * \brief   Advances the read pointer by the specified size.
+ * \param   size    The number of elements to advance the read pointer by.
+ * \returns True if the read pointer was successfully advanced; false if
+ *          the size is invalid or no data is available. Returns true if
+ *          size is 0, as no update occurs.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::Read(const size_t size)
+{
+    // Handle invalid size
+    if (0 == size) {
+        return true; // No update is done
+    }
+    if (size > mCapacity) {
+        return false; // Size is not within valid range
+    }
+
+    const auto read  = mRead.load(std::memory_order_relaxed);
+    const auto write = mWrite.load(std::memory_order_acquire);
+
+    if (size <= write - read) {                                 // Requested size available?
+        mRead.store(read + size, std::memory_order_release);
+        return true;
+    }
+
+    return false;                                               // Buffer empty or invalid size
+}
+
+/**
+ * \brief   Returns the number of elements currently in the buffer.
+ * \remark  This value is a snapshot and may be slightly inaccurate due to
+ *          concurrent read or write operations.
+ * \returns The total number of elements in the buffer.
+ */
+template<typename T>
+size_t MagicRingbuffer<T>::Size() const
+{
+    const auto read  = mRead.load(std::memory_order_acquire);
+    const auto write = mWrite.load(std::memory_order_acquire);
+
+    return write - read;
+}
+
+/**
+ * \brief   Returns the maximum number of elements the buffer can hold.
+ * \returns The capacity of the buffer, the requested size rounded up to a
+ *          whole number of pages.
+ */
+template<typename T>
+size_t MagicRingbuffer<T>::Capacity() const
+{
+    return mCapacity;
+}
+
+/**
+ * \brief   Clears the buffer.
+ * \details Resets the write and read pointers, effectively emptying the buffer.
+ */
+template<typename T>
+void MagicRingbuffer<T>::Clear()
+{
+    mWrite.store(0, std::memory_order_release);
+    mRead.store(0, std::memory_order_release);
+}
+
+/**
+ * \brief   Checks if the buffer's atomic operations are lock-free.
+ * \returns True if all atomic operations are lock-free; otherwise, false.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::IsLockFree() const
+{
+    return (mWrite.is_lock_free() && mRead.is_lock_free());
+}
+
+#ifdef DEBUG
+/**
+ * \brief   Debug method to force a state to be set to the mWrite/mRead pointers.
+ * \param   write   Value to set mWrite to.
+ * \param   read    Value to set mRead to.
+ * \remarks There are no checks, so know what you are doing!
+ */
+template<typename T>
+void MagicRingbuffer<T>::SetState(size_t write, size_t read)
+{
+    #warning DEBUG method SetState() enabled - carefull, there be dragons here.
+
+    mWrite.store(write, std::memory_order_release);
+    mRead.store(read, std::memory_order_release);
+}
+
+/**
+ * \brief   Debug method to check the state of the mWrite/mRead pointers.
+ * \param   write   Value to check mWrite against.
+ * \param   read    Value to check mRead against.
+ * \returns True if the state matches, else false.
+ */
+template<typename T>
+bool MagicRingbuffer<T>::CheckState(size_t write, size_t read)
+{
+    #warning DEBUG method CheckState() enabled.
+
+    return ( ( write == mWrite.load(std::memory_order_acquire) ) &&
+             ( read  == mRead.load(std::memory_order_acquire)  ) );
+}
+#endif // DEBUG
+
+/**
+ * \brief   Unmaps both mappings. No effect when not mapped.
+ */
+template<typename T>
+void MagicRingbuffer<T>::Unmap()
+{
+    if (nullptr != mElements) {
+        munmap(mElements, 2 * mBytes);
+    }
+
+    mWrite.store(0, std::memory_order_release);
+    mRead.store(0, std::memory_order_release);
+    mCapacity = 0;
+    mBytes    = 0;
+    mElements = nullptr;
+}
+
+#endif // MAGIC_RING_BUFFER_HPP_
@@ -0,0 +1,376 @@
+/**
+ * \file RecordQueue.hpp
+ *
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ * \class   RecordQueue
+ *
+ * \brief   Single-Producer, Single-Consumer, lock free queue of variable
+ *          length records, on top of ContiguousRingbuffer<uint8_t>.
+ *
+ * \details Each record is stored as an aligned header (length, type)
+ *          followed by the payload, padded to the alignment. The record is
+ *          committed as a single block with 'Poke()'/'Write()', so the wrap
+ *          logic of the ContiguousRingbuffer guarantees the header and the
+ *          payload are contiguous. The consumer gets the payload in place:
+ *          'PeekRecord()' and 'ReleaseRecord()' only touch the header, and
+ *          'NextRecord()' steps through the records queued after it in the
+ *          same contiguous block, so several records can be handled before
+ *          releasing them with 'ReleaseRecords()'.
+ *
+ * \note    The payload is aligned to 'Alignment', at most the alignment
+ *          guaranteed by 'new' for the underlying buffer.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.0
+ * \date    10-2026
+ */
+
+#ifndef RECORD_QUEUE_HPP_
+#define RECORD_QUEUE_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include "ContiguousRingbuffer.hpp"
+
+
+/******************************************************************************
+ * Types                                                                      *
+ *****************************************************************************/
+/**
+ * \struct  RecordHeader
+ * \brief   Header stored in front of each payload.
+ */
+struct RecordHeader
+{
+    uint32_t length;                                            // Payload length in bytes
+    uint16_t type;                                              // User defined record type
+    uint16_t reserved;                                          // Always 0
+};
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<size_t Alignment = alignof(std::max_align_t)>
+class RecordQueue
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Alignment >= alignof(RecordHeader), "Alignment must fit the record header");
+    static_assert(Alignment <= alignof(std::max_align_t), "Alignment exceeds the alignment guaranteed by new");
+
+public:
+    /**
+     * \struct  Record
+     * \brief   A record in the queue, the payload is not copied.
+     */
+    struct Record
+    {
+        uint16_t       type{0};
+        size_t         length{0};
+        const uint8_t* payload{nullptr};
+
+    private:
+        friend class RecordQueue;
+        const uint8_t* block{nullptr};                          // Start of the contiguous block peeked
+        size_t         available{0};                            // Size of the contiguous block peeked
+        size_t         end{0};                                  // Offset of the end of this record in the block
+    };
+
+    RecordQueue() noexcept = default;
+
+    bool Resize(const size_t bytes) noexcept;
+
+    bool PokeRecord(uint8_t* &payload, const size_t length);
+    bool WriteRecord(const uint16_t type);
+    bool PushRecord(const uint16_t type, const uint8_t* src, const size_t length);
+
+    bool PeekRecord(Record& record);
+    bool NextRecord(Record& record) const;
+    bool ReleaseRecord();
+    bool ReleaseRecords(const Record& last);
+
+    bool IsEmpty() const;
+    size_t Capacity() const;
+    void Clear();
+    bool IsLockFree() const;
+
+    static constexpr size_t FrameSize(const size_t length);
+    static constexpr size_t HeaderSize = ((sizeof(RecordHeader) + Alignment - 1) / Alignment) * Alignment;
+
+private:
+    ContiguousRingbuffer<uint8_t> mBuffer;
+    uint8_t* mPoked{nullptr};                                   // Producer's reserved record
+    size_t   mPokedLength{0};
+
+    static bool Parse(const uint8_t* block, const size_t available, const size_t offset, Record& record);
+};
+
+
+/**
+ * \brief   Resizes the queue to the specified number of bytes.
+ * \details Frees existing memory and allocates new memory for the underlying
+ *          buffer. Not thread safe.
+ * \param   bytes   The number of bytes to allocate, including the headers
+ *                  and padding of the records (must be greater than 0).
+ * \returns True if allocation is successful; false if bytes is 0 or allocation fails.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::Resize(const size_t bytes) noexcept
+{
+    mPoked = nullptr;
+    mPokedLength = 0;
+
+    return mBuffer.Resize(bytes);
+}
+
+/**
+ * \brief   Reserves a contiguous record with a payload of 'length' bytes.
+ * \details Returns a pointer to the aligned payload. The user must call
+ *          'WriteRecord()' to commit the record. Calling 'PokeRecord()'
+ *          again replaces the reservation.
+ * \param   payload Reference to a pointer that will point to the payload if
+ *                  space is available; otherwise, nullptr.
+ * \param   length  The payload length in bytes, may be 0.
+ * \returns True if the record fits; false if it is too large or no
+ *          contiguous space is available.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::PokeRecord(uint8_t*& payload, const size_t length)
+{
+    mPoked = nullptr;
+    payload = nullptr;
+
+    // Handle invalid length
+    if (length > std::numeric_limits<uint32_t>::max() || FrameSize(length) > mBuffer.Capacity()) {
+        return false; // Record can never fit
+    }
+
+    uint8_t* dest = nullptr;
+    size_t size = FrameSize(length);
+    if (!mBuffer.Poke(dest, size)) {
+        return false; // No contiguous space available
+    }
+
+    mPoked = dest;
+    mPokedLength = length;
+    payload = dest + HeaderSize;
+    return true;
+}
+
+/**
+ * \brief   Commits the record reserved with 'PokeRecord()'.
+ * \details Stores the header in front of the payload, then commits the
+ *          header, payload and padding as a single block.
+ * \param   type    The user defined record type.
+ * \returns True if the record was committed; false if no record was reserved.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::WriteRecord(const uint16_t type)
+{
+    if (nullptr == mPoked) {
+        return false; // Nothing reserved
+    }
+
+    auto header = new (mPoked) RecordHeader;
+    header->length   = static_cast<uint32_t>(mPokedLength);
+    header->type     = type;
+    header->reserved = 0;
+
+    mPoked = nullptr;
+    return mBuffer.Write(FrameSize(mPokedLength));
+}
+
+/**
+ * \brief   Copies a payload into the queue as a single record.
+ * \param   type    The user defined record type.
+ * \param   src     The payload to copy, may be nullptr if length is 0.
+ * \param   length  The payload length in bytes.
+ * \returns True if the record was queued; false if it does not fit or src is nullptr.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::PushRecord(const uint16_t type, const uint8_t* src, const size_t length)
+{
+    if ((nullptr == src) && (length > 0)) {
+        return false; // Invalid source
+    }
+
+    uint8_t* payload = nullptr;
+    if (!PokeRecord(payload, length)) {
+        return false;
+    }
+
+    std::copy(src, src + length, payload);
+    return WriteRecord(type);
+}
+
+/**
+ * \brief   Returns the oldest record in the queue.
+ * \details The payload is accessed in place, it remains valid until the
+ *          record is released. Use 'NextRecord()' to step to the records
+ *          after it.
+ * \param   record  Updated to the oldest record.
+ * \returns True if a record is available; false if the queue is empty.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::PeekRecord(Record& record)
+{
+    uint8_t* block = nullptr;
+    size_t size = HeaderSize;
+
+    if (!mBuffer.Peek(block, size)) {
+        return false; // Queue empty
+    }
+    return Parse(block, size, 0, record);
+}
+
+/**
+ * \brief   Steps to the record after 'record'.
+ * \details Only records in the same contiguous block are visited: at the
+ *          end of the buffer, or when the producer did not commit more yet,
+ *          this returns false. Release the records and call 'PeekRecord()'
+ *          to continue.
+ * \param   record  A record obtained from 'PeekRecord()' or 'NextRecord()',
+ *                  updated to the next record.
+ * \returns True if a next record is available; false otherwise, 'record'
+ *          is not changed then.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::NextRecord(Record& record) const
+{
+    if (nullptr == record.block) {
+        return false; // Not a peeked record
+    }
+    return Parse(record.block, record.available, record.end, record);
+}
+
+/**
+ * \brief   Releases the oldest record in the queue.
+ * \returns True if a record was released; false if the queue is empty.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::ReleaseRecord()
+{
+    Record record;
+    if (!PeekRecord(record)) {
+        return false; // Queue empty
+    }
+    return mBuffer.Read(record.end);
+}
+
+/**
+ * \brief   Releases all records up to and including 'last'.
+ * \param   last    A record obtained from 'PeekRecord()' or 'NextRecord()',
+ *                  no records may have been released since.
+ * \returns True if the records were released; false otherwise.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::ReleaseRecords(const Record& last)
+{
+    if (nullptr == last.block) {
+        return false; // Not a peeked record
+    }
+    return mBuffer.Read(last.end);
+}
+
+/**
+ * \brief   Checks if the queue holds no records.
+ * \remark  This value is a snapshot.
+ * \returns True if the queue is empty, else false.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::IsEmpty() const
+{
+    return (0 == mBuffer.Size());
+}
+
+/**
+ * \brief   Returns the size of the underlying buffer.
+ * \returns The number of bytes, including the headers and padding of the records.
+ */
+template<size_t Alignment>
+size_t RecordQueue<Alignment>::Capacity() const
+{
+    return mBuffer.Capacity();
+}
+
+/**
+ * \brief   Clears the queue. Not thread safe.
+ */
+template<size_t Alignment>
+void RecordQueue<Alignment>::Clear()
+{
+    mPoked = nullptr;
+    mPokedLength = 0;
+    mBuffer.Clear();
+}
+
+/**
+ * \brief   Checks if the queue's atomic operations are lock-free.
+ * \returns True if all atomic operations are lock-free; otherwise, false.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::IsLockFree() const
+{
+    return mBuffer.IsLockFree();
+}
+
+/**
+ * \brief   Returns the number of bytes a record occupies in the queue.
+ * \param   length  The payload length in bytes.
+ * \returns The size of the header, the payload and the padding.
+ */
+template<size_t Alignment>
+constexpr size_t RecordQueue<Alignment>::FrameSize(const size_t length)
+{
+    return HeaderSize + ((length + Alignment - 1) / Alignment) * Alignment;
+}
+
+template<size_t Alignment>
+constexpr size_t RecordQueue<Alignment>::HeaderSize;
+
+/************************************************************************/
+/* Private Members                                                      */
+/************************************************************************/
+/**
+ * \brief   Parses the record at 'offset' in a contiguous block.
+ * \param   block       The start of the contiguous block.
+ * \param   available   The size of the contiguous block.
+ * \param   offset      The offset of the header in the block.
+ * \param   record      Updated to the record if the block holds it completely.
+ * \returns True if a record was parsed, else false.
+ */
+template<size_t Alignment>
+bool RecordQueue<Alignment>::Parse(const uint8_t* block, const size_t available, const size_t offset, Record& record)
+{
+    if ((available < offset) || ((available - offset) < HeaderSize)) {
+        return false; // No header in the block
+    }
+
+    const auto header = reinterpret_cast<const RecordHeader*>(block + offset);
+    const auto frame = FrameSize(header->length);
+    if ((available - offset) < frame) {
+        return false; // Robustness, records are committed as a whole
+    }
+
+    record.type      = header->type;
+    record.length    = header->length;
+    record.payload   = block + offset + HeaderSize;
+    record.block     = block;
+    record.available = available;
+    record.end       = offset + frame;
+    return true;
+}
+
+#endif // RECORD_QUEUE_HPP_
@@ -0,0 +1,334 @@
+#include <gtest/gtest.h>
+#include "BroadcastRingbuffer.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class TEST_BroadcastRingbuffer : public ::testing::Test {
+protected:
+    BroadcastRingbuffer<int> mRingBuffer;
+    const size_t mCapacity = 16;
+    const size_t mReaders = 3;
+
+    void SetUp() override {
+        EXPECT_TRUE(mRingBuffer.Resize(mCapacity, mReaders));
+    }
+
+    // Write 'size' consecutive values starting at 'value'
+    bool WriteBlock(int value, size_t size) {
+        int* data = nullptr;
+        size_t available = size;
+        if (!mRingBuffer.Poke(data, available)) {
+            return false;
+        }
+        for (size_t i = 0; i < size; i++) {
+            data[i] = value + static_cast<int>(i);
+        }
+        return mRingBuffer.Write(size);
+    }
+
+    // Read a block of 'size' values, expecting consecutive values starting at 'value'
+    bool ReadBlock(size_t reader, int value, size_t size) {
+        int* data = nullptr;
+        size_t available = size;
+        if (!mRingBuffer.Peek(reader, data, available)) {
+            return false;
+        }
+        for (size_t i = 0; i < size; i++) {
+            EXPECT_EQ(data[i], value + static_cast<int>(i));
+        }
+        return mRingBuffer.Read(reader, size);
+    }
+};
+
+TEST_F(TEST_BroadcastRingbuffer, Resize) {
+    EXPECT_EQ(mRingBuffer.Capacity(), mCapacity);
+    EXPECT_EQ(mRingBuffer.Readers(), mReaders);
+    EXPECT_TRUE(mRingBuffer.IsLockFree());
+
+    EXPECT_FALSE(mRingBuffer.Resize(0, 1));
+    EXPECT_EQ(mRingBuffer.Capacity(), 0);
+    EXPECT_FALSE(mRingBuffer.Resize(1, 0));
+    EXPECT_EQ(mRingBuffer.Readers(), 0);
+
+    EXPECT_TRUE(mRingBuffer.Resize(1, 1));
+    EXPECT_EQ(mRingBuffer.Capacity(), 1);
+    EXPECT_EQ(mRingBuffer.Limit() % 2, 0);          // Even number of laps
+}
+
+TEST_F(TEST_BroadcastRingbuffer, InvalidArguments) {
+    int* data = nullptr;
+    size_t size = 0;
+
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));
+    size = mCapacity + 1;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(data, nullptr);
+    EXPECT_EQ(size, 0);
+
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Peek(mReaders, data, size));
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Peek(0, data, size));  // Buffer empty
+
+    EXPECT_TRUE(mRingBuffer.Write(0));
+    EXPECT_FALSE(mRingBuffer.Write(mCapacity + 1));
+    EXPECT_TRUE(mRingBuffer.Read(0, 0));
+    EXPECT_FALSE(mRingBuffer.Read(0, 1));
+    EXPECT_FALSE(mRingBuffer.Read(mReaders, 0));
+    EXPECT_EQ(mRingBuffer.Size(mReaders), 0);
+    EXPECT_EQ(mRingBuffer.Overruns(mReaders), 0);
+}
+
+TEST_F(TEST_BroadcastRingbuffer, EveryReaderSeesEveryBlock) {
+    EXPECT_TRUE(WriteBlock(0, 5));
+    EXPECT_TRUE(WriteBlock(5, 3));
+
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_EQ(mRingBuffer.Size(reader), 8);
+        EXPECT_TRUE(ReadBlock(reader, 0, 5));
+        EXPECT_TRUE(ReadBlock(reader, 5, 3));
+        EXPECT_EQ(mRingBuffer.Size(reader), 0);
+    }
+}
+
+TEST_F(TEST_BroadcastRingbuffer, FreeSpaceIsMinimumOverReaders) {
+    int* data = nullptr;
+    size_t size = mCapacity;
+
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));      // No extra element needed
+    EXPECT_EQ(size, mCapacity);
+    EXPECT_TRUE(WriteBlock(0, mCapacity));
+
+    EXPECT_TRUE(ReadBlock(0, 0, mCapacity));        // Fast reader
+    EXPECT_TRUE(ReadBlock(1, 0, 4));                // Slow reader
+
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));     // Reader 2 did not read
+    EXPECT_FALSE(mRingBuffer.Write(1));
+
+    EXPECT_TRUE(ReadBlock(2, 0, 10));
+    size = 1;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(size, 4);                             // Limited by reader 1
+    EXPECT_FALSE(mRingBuffer.Write(5));
+    EXPECT_TRUE(WriteBlock(16, 4));
+}
+
+TEST_F(TEST_BroadcastRingbuffer, BlockIsContiguousAtEndOfBuffer) {
+    EXPECT_TRUE(WriteBlock(0, 10));
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_TRUE(ReadBlock(reader, 0, 10));
+    }
+
+    int* start = nullptr;
+    size_t size = 6;
+    EXPECT_TRUE(mRingBuffer.Poke(start, size));     // Fits at the end
+    EXPECT_EQ(size, 6);
+
+    int* data = nullptr;
+    size = 8;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));      // Placed at the start
+    EXPECT_EQ(size, 10);                            // Skipped 6 elements at the end
+    EXPECT_EQ(data, start - 10);
+
+    EXPECT_TRUE(WriteBlock(10, 8));
+    EXPECT_EQ(mRingBuffer.Size(0), 14);             // Includes the skipped elements
+
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        size = 1;
+        EXPECT_TRUE(mRingBuffer.Peek(reader, data, size));
+        EXPECT_EQ(size, 8);
+        EXPECT_EQ(data, start - 10);
+        EXPECT_TRUE(ReadBlock(reader, 10, 8));
+    }
+}
+
+TEST_F(TEST_BroadcastRingbuffer, ExactFitAtEndOfBuffer) {
+    EXPECT_TRUE(WriteBlock(0, 10));
+    EXPECT_TRUE(WriteBlock(10, 6));
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_TRUE(ReadBlock(reader, 0, 10));
+        EXPECT_TRUE(ReadBlock(reader, 10, 6));
+    }
+    EXPECT_TRUE(WriteBlock(16, 16));
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_TRUE(ReadBlock(reader, 16, 16));
+    }
+}
+
+TEST_F(TEST_BroadcastRingbuffer, PositionsWrapAtLimit) {
+    const size_t limit = mRingBuffer.Limit();
+    mRingBuffer.SetState(limit - 5, limit - 5);     // 5 elements before the end of the buffer
+
+    EXPECT_TRUE(WriteBlock(0, 3));
+    EXPECT_TRUE(WriteBlock(3, 4));                  // Placed at the start, positions wrap
+    EXPECT_TRUE(WriteBlock(7, 7));
+    EXPECT_FALSE(WriteBlock(14, 1));                // Full, including 2 skipped elements
+
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_TRUE(ReadBlock(reader, 0, 3));
+        EXPECT_TRUE(ReadBlock(reader, 3, 4));
+        EXPECT_TRUE(ReadBlock(reader, 7, 7));
+        EXPECT_EQ(mRingBuffer.Size(reader), 0);
+    }
+    EXPECT_TRUE(WriteBlock(14, 5));                  // Exact fit at the end
+    EXPECT_TRUE(WriteBlock(19, 11));
+}
+
+TEST_F(TEST_BroadcastRingbuffer, OverrunDetectedAtPeek) {
+    EXPECT_TRUE(mRingBuffer.Resize(mCapacity, 2, true));
+
+    int value = 0;
+    for (int block = 0; block < 10; block++) {      // Reader 1 never reads
+        EXPECT_TRUE(WriteBlock(value, 5));
+        EXPECT_TRUE(ReadBlock(0, value, 5));
+        value += 5;
+    }
+    EXPECT_EQ(mRingBuffer.Overruns(0), 0);
+
+    int* data = nullptr;
+    size_t size = 1;
+    EXPECT_FALSE(mRingBuffer.Peek(1, data, size));  // Continues at the newest data
+    EXPECT_EQ(mRingBuffer.Overruns(1), 1);
+    EXPECT_EQ(mRingBuffer.Size(1), 0);
+
+    EXPECT_TRUE(WriteBlock(value, 5));
+    EXPECT_TRUE(ReadBlock(1, value, 5));
+    EXPECT_EQ(mRingBuffer.Overruns(1), 1);
+}
+
+TEST_F(TEST_BroadcastRingbuffer, OverrunDetectedAtRead) {
+    EXPECT_TRUE(mRingBuffer.Resize(mCapacity, 1, true));
+    EXPECT_TRUE(WriteBlock(0, 8));
+
+    int* data = nullptr;
+    size_t size = 1;
+    EXPECT_TRUE(mRingBuffer.Peek(0, data, size));
+    EXPECT_EQ(size, 8);
+
+    EXPECT_TRUE(WriteBlock(8, 8));                  // Writer is not stalled
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));      // Claims the block being read
+    EXPECT_EQ(size, 8);
+
+    EXPECT_FALSE(mRingBuffer.Read(0, 8));
+    EXPECT_EQ(mRingBuffer.Overruns(0), 1);
+
+    for (int i = 0; i < 8; i++) {
+        data[i] = 16 + i;
+    }
+    EXPECT_TRUE(mRingBuffer.Write(8));
+    EXPECT_TRUE(ReadBlock(0, 16, 8));               // Continued at the newest data
+    EXPECT_EQ(mRingBuffer.Overruns(0), 1);
+}
+
+TEST_F(TEST_BroadcastRingbuffer, Clear) {
+    EXPECT_TRUE(WriteBlock(0, 8));
+    mRingBuffer.Clear();
+    for (size_t reader = 0; reader < mReaders; reader++) {
+        EXPECT_EQ(mRingBuffer.Size(reader), 0);
+    }
+    EXPECT_TRUE(WriteBlock(0, mCapacity));
+}
+
+TEST_F(TEST_BroadcastRingbuffer, Threading) {
+    const uint32_t blocks = 20000;
+    EXPECT_TRUE(mRingBuffer.Resize(64, mReaders));
+
+    auto writer = [&]() {
+        int value = 0;
+        for (uint32_t block = 0; block < blocks; block++) {
+            const size_t size = 1 + (block % 13);
+            while (!WriteBlock(value, size)) {
+                std::this_thread::yield();
+            }
+            value += static_cast<int>(size);
+        }
+    };
+
+    std::atomic<uint32_t> errors{0};
+    auto reader = [&](size_t index) {
+        int expected = 0;
+        for (uint32_t block = 0; block < blocks; block++) {
+            const size_t size = 1 + (block % 13);
+            int* data = nullptr;
+            size_t available = size;
+            while (!mRingBuffer.Peek(index, data, available)) {
+                available = size;
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < size; i++) {
+                if (data[i] != expected++) {
+                    errors++;
+                }
+            }
+            EXPECT_TRUE(mRingBuffer.Read(index, size));
+        }
+    };
+
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < mReaders; i++) {
+        readers.emplace_back(reader, i);
+    }
+    std::thread producer(writer);
+
+    producer.join();
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors, 0);
+    for (size_t i = 0; i < mReaders; i++) {
+        EXPECT_EQ(mRingBuffer.Size(i), 0);
+        EXPECT_EQ(mRingBuffer.Overruns(i), 0);
+    }
+}
+
+TEST_F(TEST_BroadcastRingbuffer, ThreadingOverrun) {
+    const uint32_t blocks = 20000;
+    EXPECT_TRUE(mRingBuffer.Resize(64, 1, true));
+
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> received{0};
+    uint32_t written = 0;
+    std::thread producer([&]() {
+        int value = 0;
+        // Continue until the reader got a block, an overtaken reader skips to the newest data
+        for (uint32_t block = 0; (block < blocks) || (received == 0); block++) {
+            EXPECT_TRUE(WriteBlock(value, 8));      // Never stalls
+            value += 8;
+            written++;
+            if ((block % 64) == 0) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    // A block which was read successfully holds consecutive values
+    uint32_t errors = 0;
+    while (!done || mRingBuffer.Size(0) > 0) {
+        int* data = nullptr;
+        size_t size = 8;
+        if (mRingBuffer.Peek(0, data, size)) {
+            int copy[8];
+            std::copy(data, data + 8, copy);
+            if (mRingBuffer.Read(0, 8)) {
+                received++;
+                for (size_t i = 1; i < 8; i++) {
+                    errors += (copy[i] != copy[0] + static_cast<int>(i)) ? 1 : 0;
+                }
+            }
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_GT(received, 0);
+    EXPECT_LE(received, written);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "ContiguousRingbuffer.hpp"
+
+class TEST_Grow : public ::testing::Test {
+protected:
+    ContiguousRingbuffer<int> mRingBuffer;
+
+    void SetUp() override {
+        EXPECT_EQ(mRingBuffer.Size(), 0);
+    }
+
+    void TearDown() override
+    {
+        mRingBuffer.Clear();
+    };
+
+    // Helper method to set the state of the ring buffer, and number the elements in it 1, 2, 3, ...
+    size_t SetRingBufferState(int write, int read, int wrap) {
+        mRingBuffer.SetState(write, read, wrap);
+
+        int* first = nullptr;
+        int* second = nullptr;
+        size_t firstSize = 0;
+        size_t secondSize = 0;
+        mRingBuffer.PeekSegments(first, firstSize, second, secondSize);
+
+        int value = 1;
+        for (size_t i = 0; i < firstSize; i++) {
+            first[i] = value++;
+        }
+        for (size_t i = 0; i < secondSize; i++) {
+            second[i] = value++;
+        }
+        return firstSize + secondSize;
+    }
+
+    // Helper method to check the elements are contiguous and numbered 1, 2, 3, ...
+    void CheckContents(size_t count) {
+        EXPECT_EQ(mRingBuffer.Size(), count);
+        if (count == 0) {
+            return;
+        }
+
+        int* data = nullptr;
+        size_t size = count;
+        EXPECT_TRUE(mRingBuffer.Peek(data, size));
+        ASSERT_EQ(size, count);                                 // Linearized: all data in a single block
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(data[i], static_cast<int>(i + 1));
+        }
+    }
+};
+
+TEST_F(TEST_Grow, InvalidSize) {
+    EXPECT_TRUE(mRingBuffer.Resize(10));
+    EXPECT_FALSE(mRingBuffer.Grow(9));                          // Shrinking is not allowed
+    EXPECT_EQ(mRingBuffer.Capacity(), 10);
+
+    EXPECT_TRUE(mRingBuffer.Grow(10));                          // Same size is allowed
+    EXPECT_EQ(mRingBuffer.Capacity(), 10);
+}
+
+TEST_F(TEST_Grow, GrowWithoutResize) {
+    EXPECT_FALSE(mRingBuffer.Grow(0));
+
+    EXPECT_TRUE(mRingBuffer.Grow(10));                          // Acts as Resize()
+    EXPECT_EQ(mRingBuffer.Capacity(), 10);
+    EXPECT_TRUE(mRingBuffer.CheckState(0, 0, 11));
+}
+
+TEST_F(TEST_Grow, GrowEmptyAtEnd) {
+    EXPECT_TRUE(mRingBuffer.Resize(3));
+    EXPECT_EQ(SetRingBufferState(3, 3, 4), 0);                  // Empty, read and write at the end
+
+    EXPECT_TRUE(mRingBuffer.Grow(6));
+    EXPECT_TRUE(mRingBuffer.CheckState(0, 0, 7));
+    CheckContents(0);
+
+    int* data = nullptr;
+    size_t size = 1;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(size, 6);
+}
+
+TEST_F(TEST_Grow, GrowUnwrapped) {
+    EXPECT_TRUE(mRingBuffer.Resize(20));
+    EXPECT_EQ(SetRingBufferState(10, 3, 21), 7);                // Data in the middle
+
+    EXPECT_TRUE(mRingBuffer.Grow(40));
+    EXPECT_TRUE(mRingBuffer.CheckState(7, 0, 41));
+    EXPECT_EQ(mRingBuffer.Capacity(), 40);
+    CheckContents(7);
+}
+
+TEST_F(TEST_Grow, GrowWrapShrunkToRead) {
+    EXPECT_TRUE(mRingBuffer.Resize(3));
+    EXPECT_EQ(SetRingBufferState(2, 3, 3), 2);                  // Wrap shrunk to read, data at the start only
+
+    EXPECT_TRUE(mRingBuffer.Grow(5));
+    EXPECT_TRUE(mRingBuffer.CheckState(2, 0, 6));
+    CheckContents(2);
+}
+
+TEST_F(TEST_Grow, GrowWrapShrunkBeyondRead) {
+    EXPECT_TRUE(mRingBuffer.Resize(4));
+    EXPECT_EQ(SetRingBufferState(2, 3, 4), 3);                  // Data at the end up to shrunk wrap, and at the start
+
+    EXPECT_TRUE(mRingBuffer.Grow(8));
+    EXPECT_TRUE(mRingBuffer.CheckState(3, 0, 9));
+    CheckContents(3);
+}
+
+TEST_F(TEST_Grow, GrowReadEqualToWrap) {
+    EXPECT_TRUE(mRingBuffer.Resize(4));
+    EXPECT_EQ(SetRingBufferState(2, 4, 4), 2);                  // Read at shrunk wrap, data at the start
+
+    EXPECT_TRUE(mRingBuffer.Grow(4));
+    EXPECT_TRUE(mRingBuffer.CheckState(2, 0, 5));
+    CheckContents(2);
+}
+
+TEST_F(TEST_Grow, GrowWrappedLargeBuffer) {
+    EXPECT_TRUE(mRingBuffer.Resize(20));
+    EXPECT_EQ(SetRingBufferState(10, 14, 21), 17);              // Wrapped without shrinking wrap
+
+    EXPECT_TRUE(mRingBuffer.Grow(30));
+    EXPECT_TRUE(mRingBuffer.CheckState(17, 0, 31));
+    CheckContents(17);
+
+    EXPECT_TRUE(mRingBuffer.Resize(20));
+    EXPECT_EQ(SetRingBufferState(10, 14, 14), 10);              // Wrap shrunk to read
+
+    EXPECT_TRUE(mRingBuffer.Grow(30));
+    EXPECT_TRUE(mRingBuffer.CheckState(10, 0, 31));
+    CheckContents(10);
+}
+
+TEST_F(TEST_Grow, GrowFullBuffer) {
+    EXPECT_TRUE(mRingBuffer.Resize(20));
+    EXPECT_EQ(SetRingBufferState(4, 5, 21), 20);                // Full, wrapped
+
+    EXPECT_TRUE(mRingBuffer.Grow(25));
+    EXPECT_TRUE(mRingBuffer.CheckState(20, 0, 26));
+    CheckContents(20);
+
+    int* data = nullptr;
+    size_t size = 1;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));                  // Space added at the end
+    EXPECT_EQ(size, 5);
+}
+
+TEST_F(TEST_Grow, GrowMappedStorage) {
+    AllocationPolicy policy;
+    policy.pages = AllocationPolicy::Pages::Transparent;
+
+    EXPECT_TRUE(mRingBuffer.Resize(20, policy));
+    EXPECT_EQ(SetRingBufferState(10, 3, 21), 7);                // Unwrapped: pages remapped, nothing moved
+
+    EXPECT_TRUE(mRingBuffer.Grow(1024 * 1024));
+    EXPECT_TRUE(mRingBuffer.CheckState(10, 3, 1024 * 1024 + 1));
+    CheckContents(7);
+
+    EXPECT_EQ(SetRingBufferState(10, 1000000, 1048577), 48587); // Wrapped: rotated in place
+
+    EXPECT_TRUE(mRingBuffer.Grow(2 * 1024 * 1024));
+    EXPECT_TRUE(mRingBuffer.CheckState(48587, 0, 2 * 1024 * 1024 + 1));
+    CheckContents(48587);
+}
+
+TEST_F(TEST_Grow, WriteAndReadAfterGrow) {
+    EXPECT_TRUE(mRingBuffer.Resize(4));
+    EXPECT_EQ(SetRingBufferState(2, 3, 4), 3);
+
+    EXPECT_TRUE(mRingBuffer.Grow(10));
+
+    int* data = nullptr;
+    size_t size = 5;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(size, 7);
+    for (int i = 0; i < 5; i++) {
+        data[i] = 4 + i;
+    }
+    EXPECT_TRUE(mRingBuffer.Write(5));
+    CheckContents(8);
+
+    EXPECT_TRUE(mRingBuffer.Read(8));
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+}
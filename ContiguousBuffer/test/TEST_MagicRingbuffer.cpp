@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include "MagicRingbuffer.hpp"
+#include "ContiguousRingbuffer.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t, uint32_t
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+class TEST_MagicRingbuffer : public ::testing::Test {
+protected:
+    MagicRingbuffer<int> mRingBuffer;
+    size_t mCapacity = 0;
+
+    void SetUp() override {
+        EXPECT_TRUE(mRingBuffer.Resize(40));
+        mCapacity = mRingBuffer.Capacity();
+        EXPECT_EQ(mRingBuffer.Size(), 0);
+    }
+};
+
+TEST_F(TEST_MagicRingbuffer, Resize) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    EXPECT_EQ(mCapacity, page / sizeof(int));       // Rounded up to a whole page
+    EXPECT_TRUE(mRingBuffer.IsLockFree());
+
+    EXPECT_FALSE(mRingBuffer.Resize(0));
+    EXPECT_EQ(mRingBuffer.Capacity(), 0);
+
+    EXPECT_TRUE(mRingBuffer.Resize(page));          // Exactly 4 pages of int
+    EXPECT_EQ(mRingBuffer.Capacity(), page);
+
+    MagicRingbuffer<uint8_t> bytes;
+    EXPECT_TRUE(bytes.Resize(page + 1));
+    EXPECT_EQ(bytes.Capacity(), 2 * page);
+
+    struct Odd { uint8_t data[3]; };                // Element size not dividing a page
+    MagicRingbuffer<Odd> odd;
+    EXPECT_TRUE(odd.Resize(1));
+    EXPECT_EQ((odd.Capacity() * sizeof(Odd)) % page, 0);
+}
+
+TEST_F(TEST_MagicRingbuffer, InvalidSizes) {
+    int* data = nullptr;
+    size_t size = 0;
+
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));
+    size = mCapacity + 1;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(data, nullptr);
+    EXPECT_EQ(size, 0);
+
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Peek(data, size));     // Buffer empty
+    EXPECT_TRUE(mRingBuffer.Write(0));
+    EXPECT_TRUE(mRingBuffer.Read(0));
+    EXPECT_FALSE(mRingBuffer.Write(mCapacity + 1));
+    EXPECT_FALSE(mRingBuffer.Read(1));
+}
+
+TEST_F(TEST_MagicRingbuffer, FullCapacity) {
+    int* data = nullptr;
+    size_t size = mCapacity;
+
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));      // No extra element needed
+    EXPECT_EQ(size, mCapacity);
+    EXPECT_TRUE(mRingBuffer.Write(mCapacity));
+    EXPECT_EQ(mRingBuffer.Size(), mCapacity);
+
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));     // Buffer full
+    EXPECT_FALSE(mRingBuffer.Write(1));
+
+    size = 1;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_EQ(size, mCapacity);
+    EXPECT_TRUE(mRingBuffer.Read(mCapacity));
+    EXPECT_TRUE(mRingBuffer.CheckState(mCapacity, mCapacity));
+}
+
+TEST_F(TEST_MagicRingbuffer, BlockAcrossTheEnd) {
+    mRingBuffer.SetState(mCapacity - 2, mCapacity - 2);     // Empty, 2 elements before the end
+
+    int* data = nullptr;
+    size_t size = 10;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));      // Contiguous, no wrap needed
+    EXPECT_EQ(size, mCapacity);
+    for (int i = 0; i < 10; i++) {
+        data[i] = i;
+    }
+    EXPECT_TRUE(mRingBuffer.Write(10));
+
+    size = 10;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_EQ(size, 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(data[i], i);
+    }
+
+    // The first mapping holds the wrapped part of the block
+    int* start = nullptr;
+    size = mCapacity - 10;
+    mRingBuffer.SetState(mCapacity - 10, 0);
+    EXPECT_TRUE(mRingBuffer.Peek(start, size));
+    EXPECT_EQ(start[mCapacity - 2], 0);
+    EXPECT_EQ(start[0], 2);
+    EXPECT_EQ(start[7], 9);
+}
+
+TEST_F(TEST_MagicRingbuffer, Threading) {
+    const size_t nrOfItems = 100000;
+    const size_t blockSize = 7;
+
+    std::thread producer([this, nrOfItems, blockSize]() {
+        int value = 0;
+        for (size_t i = 0; i < nrOfItems; i += blockSize) {
+            int* data = nullptr;
+            size_t size = blockSize;
+            while (!mRingBuffer.Poke(data, size)) { std::this_thread::yield(); size = blockSize; }
+            for (size_t j = 0; j < blockSize; j++) {
+                data[j] = value++;
+            }
+            EXPECT_TRUE(mRingBuffer.Write(blockSize));
+        }
+    });
+
+    int expected = 0;
+    size_t consumed = 0;
+    while (consumed < ((nrOfItems + blockSize - 1) / blockSize) * blockSize) {
+        int* data = nullptr;
+        size_t size = 1;
+        if (mRingBuffer.Peek(data, size)) {
+            for (size_t j = 0; j < size; j++) {
+                EXPECT_EQ(data[j], expected++);
+            }
+            EXPECT_TRUE(mRingBuffer.Read(size));
+            consumed += size;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+}
+
+TEST_F(TEST_MagicRingbuffer, SpeedComparedToWrapLogic) {
+    const uint32_t nrOfRuns = 2000000;
+    const size_t blockSizes[] = { 7, 100, 333 };
+
+    ContiguousRingbuffer<int> wrapBuffer;
+    EXPECT_TRUE(wrapBuffer.Resize(mCapacity));
+
+#ifndef NDEBUG
+    std::cerr << "Using DEBUG build - results are NOT accurate" << std::endl;
+#endif // NDEBUG
+
+    for (auto blockSize : blockSizes) {
+        // Drain when three quarters full, so Poke() always succeeds for the magic buffer
+        auto run = [blockSize, this](auto& buffer) {
+            size_t fill = 0;
+            uint32_t failed = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < nrOfRuns / blockSize; i++) {
+                int* data = nullptr;
+                size_t size = blockSize;
+                const bool poked = buffer.Poke(data, size);
+                if (poked) {
+                    data[0] = static_cast<int>(i);
+                    data[blockSize - 1] = static_cast<int>(i);
+                    buffer.Write(blockSize);
+                    fill += blockSize;
+                } else {
+                    failed++;                       // No contiguous block: space lost to the wrap
+                }
+                if (!poked || (fill > (3 * mCapacity / 4))) {
+                    size = blockSize;
+                    while (buffer.Peek(data, size)) {
+                        buffer.Read(size);
+                        size = blockSize;
+                    }
+                    fill = 0;
+                }
+            }
+            auto end = std::chrono::steady_clock::now();
+            std::cerr << " " << (std::chrono::duration<double, std::milli>(end - start).count())
+                      << " ms, " << failed << " failed pokes;";
+            return failed;
+        };
+
+        std::cerr << "Block size " << blockSize << ": ContiguousRingbuffer";
+        run(wrapBuffer);
+        wrapBuffer.Clear();
+        std::cerr << " MagicRingbuffer";
+        EXPECT_EQ(run(mRingBuffer), 0);
+        mRingBuffer.Clear();
+        std::cerr << std::endl;
+    }
+}
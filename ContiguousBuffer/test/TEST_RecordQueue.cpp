@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "RecordQueue.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t, uint16_t, uintptr_t
+#include <thread>
+#include <vector>
+
+class TEST_RecordQueue : public ::testing::Test {
+protected:
+    RecordQueue<8> mQueue;
+    const size_t mBytes = 128;
+
+    void SetUp() override {
+        EXPECT_TRUE(mQueue.Resize(mBytes));
+        EXPECT_TRUE(mQueue.IsEmpty());
+    }
+
+    // Push a record of 'length' bytes, each byte set to 'value'
+    bool Push(uint16_t type, uint8_t value, size_t length) {
+        std::vector<uint8_t> payload(length, value);
+        return mQueue.PushRecord(type, payload.data(), length);
+    }
+
+    void ExpectRecord(const RecordQueue<8>::Record& record, uint16_t type, uint8_t value, size_t length) {
+        EXPECT_EQ(record.type, type);
+        EXPECT_EQ(record.length, length);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(record.payload) % 8, 0);
+        for (size_t i = 0; i < length; i++) {
+            EXPECT_EQ(record.payload[i], value);
+        }
+    }
+};
+
+TEST_F(TEST_RecordQueue, FrameSize) {
+    EXPECT_EQ(RecordQueue<8>::HeaderSize, 8);
+    EXPECT_EQ(RecordQueue<8>::FrameSize(0), 8);
+    EXPECT_EQ(RecordQueue<8>::FrameSize(1), 16);
+    EXPECT_EQ(RecordQueue<8>::FrameSize(8), 16);
+    EXPECT_EQ(RecordQueue<8>::FrameSize(9), 24);
+    EXPECT_EQ(RecordQueue<16>::HeaderSize, 16);
+    EXPECT_EQ(RecordQueue<16>::FrameSize(1), 32);
+}
+
+TEST_F(TEST_RecordQueue, InvalidArguments) {
+    RecordQueue<8>::Record record;
+    uint8_t* payload = nullptr;
+
+    EXPECT_FALSE(mQueue.Resize(0));
+    EXPECT_TRUE(mQueue.Resize(mBytes));
+
+    EXPECT_FALSE(mQueue.PokeRecord(payload, mBytes));       // Header does not fit
+    EXPECT_EQ(payload, nullptr);
+    EXPECT_FALSE(mQueue.WriteRecord(1));                    // Nothing reserved
+    EXPECT_FALSE(mQueue.PushRecord(1, nullptr, 1));
+
+    EXPECT_FALSE(mQueue.PeekRecord(record));                // Queue empty
+    EXPECT_FALSE(mQueue.NextRecord(record));
+    EXPECT_FALSE(mQueue.ReleaseRecord());
+    EXPECT_FALSE(mQueue.ReleaseRecords(record));
+}
+
+TEST_F(TEST_RecordQueue, PokeAndWriteRecord) {
+    uint8_t* payload = nullptr;
+
+    EXPECT_TRUE(mQueue.PokeRecord(payload, 5));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(payload) % 8, 0);
+    for (uint8_t i = 0; i < 5; i++) {
+        payload[i] = i;
+    }
+    EXPECT_TRUE(mQueue.WriteRecord(42));
+    EXPECT_FALSE(mQueue.WriteRecord(42));                   // Committed already
+    EXPECT_FALSE(mQueue.IsEmpty());
+
+    RecordQueue<8>::Record record;
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    EXPECT_EQ(record.type, 42);
+    EXPECT_EQ(record.length, 5);
+    EXPECT_EQ(record.payload, payload);                     // Not copied
+    EXPECT_EQ(record.payload[4], 4);
+
+    EXPECT_TRUE(mQueue.ReleaseRecord());
+    EXPECT_TRUE(mQueue.IsEmpty());
+}
+
+TEST_F(TEST_RecordQueue, EmptyPayload) {
+    EXPECT_TRUE(mQueue.PushRecord(7, nullptr, 0));
+
+    RecordQueue<8>::Record record;
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    EXPECT_EQ(record.type, 7);
+    EXPECT_EQ(record.length, 0);
+    EXPECT_TRUE(mQueue.ReleaseRecord());
+    EXPECT_TRUE(mQueue.IsEmpty());
+}
+
+TEST_F(TEST_RecordQueue, IterateWithoutCopying) {
+    EXPECT_TRUE(Push(1, 0x11, 3));
+    EXPECT_TRUE(Push(2, 0x22, 17));
+    EXPECT_TRUE(Push(3, 0x33, 8));
+
+    RecordQueue<8>::Record record;
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    ExpectRecord(record, 1, 0x11, 3);
+    EXPECT_TRUE(mQueue.NextRecord(record));
+    ExpectRecord(record, 2, 0x22, 17);
+    EXPECT_TRUE(mQueue.NextRecord(record));
+    ExpectRecord(record, 3, 0x33, 8);
+    EXPECT_FALSE(mQueue.NextRecord(record));                // No more records
+    ExpectRecord(record, 3, 0x33, 8);                       // Unchanged
+
+    EXPECT_TRUE(mQueue.PeekRecord(record));                 // Not released yet
+    EXPECT_TRUE(mQueue.NextRecord(record));
+    EXPECT_TRUE(mQueue.ReleaseRecords(record));             // Releases the first two
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    ExpectRecord(record, 3, 0x33, 8);
+    EXPECT_TRUE(mQueue.ReleaseRecords(record));
+    EXPECT_TRUE(mQueue.IsEmpty());
+}
+
+TEST_F(TEST_RecordQueue, RecordIsContiguousAtWrap) {
+    EXPECT_TRUE(Push(1, 0x11, 50));                         // 64 bytes
+    EXPECT_TRUE(Push(2, 0x22, 40));                         // 112 bytes
+    EXPECT_TRUE(mQueue.ReleaseRecord());
+
+    EXPECT_TRUE(Push(3, 0x33, 40));                         // Does not fit at the end, placed at the start
+    EXPECT_FALSE(Push(4, 0x44, 1));                         // Full
+
+    RecordQueue<8>::Record record;
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    ExpectRecord(record, 2, 0x22, 40);
+    EXPECT_FALSE(mQueue.NextRecord(record));                // Next record is at the start
+    EXPECT_TRUE(mQueue.ReleaseRecords(record));
+
+    EXPECT_TRUE(mQueue.PeekRecord(record));
+    ExpectRecord(record, 3, 0x33, 40);
+    EXPECT_TRUE(mQueue.ReleaseRecord());
+    EXPECT_TRUE(mQueue.IsEmpty());
+}
+
+TEST_F(TEST_RecordQueue, Clear) {
+    EXPECT_TRUE(Push(1, 0x11, 10));
+    uint8_t* payload = nullptr;
+    EXPECT_TRUE(mQueue.PokeRecord(payload, 10));
+
+    mQueue.Clear();
+    EXPECT_TRUE(mQueue.IsEmpty());
+    EXPECT_FALSE(mQueue.WriteRecord(1));                    // Reservation dropped
+}
+
+TEST_F(TEST_RecordQueue, Threading) {
+    const uint32_t records = 50000;
+    EXPECT_TRUE(mQueue.Resize(1024));
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < records; i++) {
+            const size_t length = i % 61;
+            uint8_t* payload = nullptr;
+            while (!mQueue.PokeRecord(payload, length)) {
+                std::this_thread::yield();
+            }
+            for (size_t j = 0; j < length; j++) {
+                payload[j] = static_cast<uint8_t>(i + j);
+            }
+            EXPECT_TRUE(mQueue.WriteRecord(static_cast<uint16_t>(i)));
+        }
+    });
+
+    uint32_t received = 0;
+    uint32_t errors = 0;
+    while (received < records) {
+        RecordQueue<8>::Record record;
+        if (!mQueue.PeekRecord(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+        do {
+            errors += (record.type != static_cast<uint16_t>(received)) ? 1 : 0;
+            errors += (record.length != (received % 61)) ? 1 : 0;
+            for (size_t j = 0; j < record.length; j++) {
+                errors += (record.payload[j] != static_cast<uint8_t>(received + j)) ? 1 : 0;
+            }
+            received++;
+        } while (mQueue.NextRecord(record));
+        EXPECT_TRUE(mQueue.ReleaseRecords(record));
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_TRUE(mQueue.IsEmpty());
+}
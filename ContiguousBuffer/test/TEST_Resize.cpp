@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "ContiguousRingbuffer.hpp"
+#include <algorithm>
 
 class TEST_Resize : public ::testing::Test {
 protected:
@@ -76,3 +77,32 @@ TEST_F(TEST_Resize, ResizeLargeToSmall) {
     mRingBuffer.Clear();
     EXPECT_EQ(mRingBuffer.Size(), 0);
 }
+
+TEST_F(TEST_Resize, ResizeWithAllocationPolicy) {
+    AllocationPolicy policy;
+    policy.pages    = AllocationPolicy::Pages::Huge;    // Falls back to transparent hugepages when none are reserved
+    policy.prefault = true;
+
+    EXPECT_FALSE(mRingBuffer.Resize(0, policy));
+    EXPECT_TRUE(mRingBuffer.Resize(100000, policy));
+    EXPECT_EQ(mRingBuffer.Capacity(), 100000);
+
+    int* data = nullptr;
+    size_t size = 100000;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(size, 100000);
+    std::fill(data, data + size, 42);
+    EXPECT_TRUE(mRingBuffer.Write(size));
+
+    size = 1;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_EQ(size, 100000);
+    EXPECT_EQ(data[99999], 42);
+    EXPECT_TRUE(mRingBuffer.Read(size));
+
+    policy.node = 1 << 20;                              // No such NUMA node
+    EXPECT_FALSE(mRingBuffer.Resize(100, policy));
+
+    EXPECT_TRUE(mRingBuffer.Resize(100, AllocationPolicy{}));
+    EXPECT_EQ(mRingBuffer.Capacity(), 100);
+}
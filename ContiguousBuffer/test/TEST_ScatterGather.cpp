@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "ContiguousRingbuffer.hpp"
+#include "ContiguousRingbufferIO.hpp"
+#include <cerrno>
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t
+#include <fcntl.h>
+#include <unistd.h>
+
+class TEST_ScatterGather : public ::testing::Test {
+protected:
+    ContiguousRingbuffer<uint8_t> mRingBuffer;
+    int mPipe[2] = { -1, -1 };
+
+    void SetUp() override {
+        EXPECT_TRUE(mRingBuffer.Resize(10));
+        EXPECT_EQ(mRingBuffer.Size(), 0);
+        EXPECT_EQ(pipe(mPipe), 0);
+        EXPECT_EQ(fcntl(mPipe[0], F_SETFL, O_NONBLOCK), 0);
+    }
+
+    void TearDown() override
+    {
+        close(mPipe[0]);
+        close(mPipe[1]);
+        mRingBuffer.Clear();
+    };
+
+    // Helper method to put 'size' bytes, starting with 'value', in the pipe
+    void SendToPipe(uint8_t value, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            EXPECT_EQ(write(mPipe[1], &value, 1), 1);
+            value++;
+        }
+    }
+
+    // Helper method to check 'size' bytes, starting with 'value', from the pipe
+    void ReceiveFromPipe(uint8_t value, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            uint8_t received = 0;
+            EXPECT_EQ(read(mPipe[0], &received, 1), 1);
+            EXPECT_EQ(received, value++);
+        }
+    }
+};
+
+TEST_F(TEST_ScatterGather, PokeSegments) {
+    uint8_t* first = nullptr;
+    uint8_t* second = nullptr;
+    size_t firstSize = 0;
+    size_t secondSize = 0;
+
+    EXPECT_TRUE(mRingBuffer.PokeSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(firstSize, 10);                       // Empty buffer, one element kept free
+    EXPECT_EQ(secondSize, 0);
+    EXPECT_EQ(second, nullptr);
+
+    mRingBuffer.SetState(6, 4, 11);                 // Space at the end and at the start
+    EXPECT_TRUE(mRingBuffer.PokeSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(firstSize, 5);
+    EXPECT_EQ(secondSize, 3);
+    EXPECT_EQ(second + 6, first);
+
+    mRingBuffer.SetState(2, 7, 9);                  // Space between write and read
+    EXPECT_TRUE(mRingBuffer.PokeSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(firstSize, 4);
+    EXPECT_EQ(secondSize, 0);
+
+    mRingBuffer.SetState(6, 7, 11);                 // Full
+    EXPECT_FALSE(mRingBuffer.PokeSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(first, nullptr);
+    EXPECT_EQ(firstSize, 0);
+}
+
+TEST_F(TEST_ScatterGather, PeekSegments) {
+    uint8_t* first = nullptr;
+    uint8_t* second = nullptr;
+    size_t firstSize = 0;
+    size_t secondSize = 0;
+
+    EXPECT_FALSE(mRingBuffer.PeekSegments(first, firstSize, second, secondSize));   // Empty
+
+    mRingBuffer.SetState(6, 4, 11);                 // Data between read and write
+    EXPECT_TRUE(mRingBuffer.PeekSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(firstSize, 2);
+    EXPECT_EQ(secondSize, 0);
+
+    mRingBuffer.SetState(2, 7, 9);                  // Data up to wrap and at the start
+    EXPECT_TRUE(mRingBuffer.PeekSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(firstSize, 2);
+    EXPECT_EQ(secondSize, 2);
+    EXPECT_EQ(second + 7, first);
+
+    mRingBuffer.SetState(2, 7, 7);                  // Wrap shrunk to read: data at the start only
+    EXPECT_TRUE(mRingBuffer.PeekSegments(first, firstSize, second, secondSize));
+    EXPECT_EQ(first, nullptr);
+    EXPECT_EQ(firstSize, 0);
+    EXPECT_EQ(secondSize, 2);
+}
+
+TEST_F(TEST_ScatterGather, FillAcrossTheEnd) {
+    mRingBuffer.SetState(6, 6, 11);                 // Empty, 5 bytes at the end, 5 at the start
+
+    SendToPipe(1, 8);
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 8); // Single readv() for both segments
+    EXPECT_TRUE(mRingBuffer.CheckState(3, 6, 11));
+    EXPECT_EQ(mRingBuffer.Size(), 8);
+
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 8);  // Single writev() for both segments
+    EXPECT_TRUE(mRingBuffer.CheckState(3, 3, 11));
+    ReceiveFromPipe(1, 8);
+
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 0);  // Empty, no system call
+}
+
+TEST_F(TEST_ScatterGather, ShortTransfers) {
+    mRingBuffer.SetState(8, 8, 11);                 // Empty, 3 bytes at the end, 7 at the start
+
+    SendToPipe(10, 2);
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 2); // Only part of the first segment
+    EXPECT_TRUE(mRingBuffer.CheckState(10, 8, 11));
+
+    SendToPipe(12, 4);
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 4); // Exact fit at the end, then the start
+    EXPECT_TRUE(mRingBuffer.CheckState(3, 8, 11));
+
+    errno = 0;
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), -1); // Pipe empty
+    EXPECT_EQ(errno, EAGAIN);
+    EXPECT_EQ(mRingBuffer.Size(), 6);
+
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 6);
+    ReceiveFromPipe(10, 6);
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+}
+
+TEST_F(TEST_ScatterGather, FullBuffer) {
+    SendToPipe(0, 12);
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 10);
+    EXPECT_EQ(mRingBuffer.Size(), 10);
+
+    errno = 0;
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), -1); // No space, no system call
+    EXPECT_EQ(errno, ENOBUFS);
+
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 10);
+    EXPECT_TRUE(mRingBuffer.CheckState(10, 10, 11));
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 10); // Remaining 2 plus 8 of the 10 just sent
+    EXPECT_TRUE(mRingBuffer.CheckState(9, 10, 11));
+    ReceiveFromPipe(8, 2);
+}
+
+TEST_F(TEST_ScatterGather, WrapShrunkToRead) {
+    mRingBuffer.SetState(3, 3, 11);
+    SendToPipe(1, 9);
+    EXPECT_EQ(FillFromFd(mRingBuffer, mPipe[0]), 9);
+    EXPECT_TRUE(mRingBuffer.CheckState(1, 3, 11));  // 8 at the end (exact fit), 1 at the start
+
+    uint8_t* data = nullptr;
+    size_t size = 8;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_TRUE(mRingBuffer.Read(8));               // Wraps read to the start
+    EXPECT_TRUE(mRingBuffer.CheckState(1, 0, 11));
+
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 1);
+    ReceiveFromPipe(9, 1);
+
+    mRingBuffer.SetState(2, 7, 7);                  // Wrap shrunk to read: data at the start only
+    EXPECT_EQ(DrainToFd(mRingBuffer, mPipe[1]), 2);
+    EXPECT_TRUE(mRingBuffer.CheckState(2, 2, 11));
+}
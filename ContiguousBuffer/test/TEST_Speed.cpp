@@ -3,6 +3,7 @@
 #include <cstddef>      // size_t
 #include <cstdint>      // uint32_t
 #include <chrono>
+#include <thread>
 
 class TEST_Speed : public ::testing::Test {
 protected:
@@ -86,3 +87,63 @@ TEST_F(TEST_Speed, SpeedCheck) {
               << (std::chrono::duration<double, std::milli>(end - start).count())
               << " milliseconds" << std::endl;
 }
+
+TEST_F(TEST_Speed, ThroughputTwoThreads) {
+    const size_t kBlockSizes[] = { 1, 7, 64, 512 };
+    const uint32_t kElements = 4000000;
+
+#ifndef NDEBUG
+    std::cerr << "Using DEBUG build - results are NOT accurate" << std::endl;
+#endif // NDEBUG
+
+    for (const auto blockSize : kBlockSizes) {
+        ContiguousRingbuffer<int> buffer;
+        EXPECT_TRUE(buffer.Resize(4096));
+
+        const uint32_t blocks = kElements / blockSize;
+        bool result = true;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread producer([&]() {
+            int value = 0;
+            for (uint32_t i = 0; i < blocks; i++) {
+                int* data = nullptr;
+                size_t size = blockSize;
+                while (!buffer.Poke(data, size)) {
+                    size = blockSize;
+                    std::this_thread::yield();
+                }
+                for (size_t j = 0; j < blockSize; j++) {
+                    data[j] = value++;
+                }
+                buffer.Write(blockSize);
+            }
+        });
+
+        int expected = 0;
+        for (uint32_t i = 0; i < blocks; i++) {
+            int* data = nullptr;
+            size_t size = blockSize;
+            while (!buffer.Peek(data, size)) {
+                size = blockSize;
+                std::this_thread::yield();
+            }
+            for (size_t j = 0; j < blockSize; j++) {
+                result &= (data[j] == expected++);
+            }
+            result &= buffer.Read(blockSize);
+        }
+        producer.join();
+
+        auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(end - start).count();
+
+        EXPECT_TRUE(result);
+        EXPECT_EQ(buffer.Size(), 0);
+
+        std::cerr << "Block size " << blockSize << ": "
+                  << (blocks / seconds) << " blocks/s, "
+                  << (blocks * blockSize * sizeof(int) / seconds) << " bytes/s" << std::endl;
+    }
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "ContiguousRingbuffer.hpp"
+#include "ContiguousRingbufferIO.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint8_t
+#include <thread>
+#include <unistd.h>
+
+// Constructed at compile time, no code runs at startup
+constexpr bool ConstructAtCompileTime() {
+    ContiguousRingbuffer<int, 4> buffer;
+    (void)buffer;
+    return true;
+}
+static_assert(ConstructAtCompileTime(), "Constructor with static capacity must be constexpr");
+
+// Indices of the smallest type holding N + 1
+static_assert(std::is_same<ContiguousRingbufferIndex<0>, size_t>::value, "Dynamic capacity uses size_t");
+static_assert(std::is_same<ContiguousRingbufferIndex<254>, uint8_t>::value, "");
+static_assert(std::is_same<ContiguousRingbufferIndex<255>, uint16_t>::value, "");
+static_assert(std::is_same<ContiguousRingbufferIndex<65534>, uint16_t>::value, "");
+static_assert(std::is_same<ContiguousRingbufferIndex<65535>, uint32_t>::value, "");
+
+static ContiguousRingbuffer<uint8_t, 16> gStaticBuffer;     // Static storage, no Resize() needed
+
+class TEST_StaticCapacity : public ::testing::Test {
+protected:
+    ContiguousRingbuffer<int, 10> mRingBuffer;
+
+    void TearDown() override
+    {
+        mRingBuffer.Clear();
+    };
+};
+
+TEST_F(TEST_StaticCapacity, InitialState) {
+    EXPECT_EQ(mRingBuffer.Capacity(), 10);
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+    EXPECT_TRUE(mRingBuffer.CheckState(0, 0, 11));
+    EXPECT_TRUE(mRingBuffer.IsLockFree());
+
+    EXPECT_EQ(gStaticBuffer.Capacity(), 16);
+    EXPECT_EQ(gStaticBuffer.Size(), 0);
+}
+
+TEST_F(TEST_StaticCapacity, PokeWritePeekRead) {
+    int* data = nullptr;
+
+    size_t size = 1;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));
+    EXPECT_EQ(size, 10);
+    for (int i = 0; i < 6; i++) {
+        data[i] = i + 1;
+    }
+    EXPECT_TRUE(mRingBuffer.Write(6));
+    EXPECT_EQ(mRingBuffer.Size(), 6);
+
+    size = 11;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));             // Larger than the capacity
+
+    size = 6;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_EQ(size, 6);
+    EXPECT_EQ(data[0], 1);
+    EXPECT_EQ(data[5], 6);
+    EXPECT_TRUE(mRingBuffer.Read(6));
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+}
+
+TEST_F(TEST_StaticCapacity, Wrap) {
+    mRingBuffer.SetState(8, 8, 11);                         // 3 elements available at end, 7 at start
+
+    int* data = nullptr;
+    size_t size = 5;
+    EXPECT_TRUE(mRingBuffer.Poke(data, size));              // Placed at the start
+    EXPECT_EQ(size, 7);
+    EXPECT_TRUE(mRingBuffer.Write(5));                      // Shrinks wrap
+    EXPECT_TRUE(mRingBuffer.CheckState(5, 8, 8));
+    EXPECT_EQ(mRingBuffer.Size(), 5);
+
+    size = 5;
+    EXPECT_TRUE(mRingBuffer.Peek(data, size));
+    EXPECT_TRUE(mRingBuffer.Read(5));                       // Restores wrap
+    EXPECT_TRUE(mRingBuffer.CheckState(5, 5, 11));
+}
+
+TEST_F(TEST_StaticCapacity, LargestUint8Capacity) {
+    ContiguousRingbuffer<uint8_t, 254> buffer;              // Indices up to 255 fit in uint8_t
+    uint8_t* data = nullptr;
+
+    size_t size = 254;
+    EXPECT_TRUE(buffer.Poke(data, size));
+    EXPECT_EQ(size, 254);
+    EXPECT_TRUE(buffer.Write(254));
+    EXPECT_EQ(buffer.Size(), 254);
+
+    size = 254;
+    EXPECT_TRUE(buffer.Peek(data, size));
+    EXPECT_TRUE(buffer.Read(254));
+    EXPECT_TRUE(buffer.CheckState(254, 254, 255));
+
+    size = 200;
+    EXPECT_TRUE(buffer.Poke(data, size));                   // Wraps to the start
+    EXPECT_TRUE(buffer.Write(200));
+    EXPECT_EQ(buffer.Size(), 200);
+}
+
+TEST_F(TEST_StaticCapacity, ScatterGather) {
+    int pipes[2] = { -1, -1 };
+    ASSERT_EQ(pipe(pipes), 0);
+
+    const uint8_t message[5] = { 1, 2, 3, 4, 5 };
+    EXPECT_EQ(write(pipes[1], message, sizeof(message)), 5);
+    EXPECT_EQ(FillFromFd(gStaticBuffer, pipes[0]), 5);
+    EXPECT_EQ(gStaticBuffer.Size(), 5);
+    EXPECT_EQ(DrainToFd(gStaticBuffer, pipes[1]), 5);
+    EXPECT_EQ(gStaticBuffer.Size(), 0);
+
+    close(pipes[0]);
+    close(pipes[1]);
+}
+
+TEST_F(TEST_StaticCapacity, Threading) {
+    const uint32_t blocks = 20000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < blocks; i++) {
+            int* data = nullptr;
+            size_t size = 3;
+            while (!mRingBuffer.Poke(data, size)) {
+                size = 3;
+                std::this_thread::yield();
+            }
+            for (int j = 0; j < 3; j++) {
+                data[j] = static_cast<int>(i * 3) + j;
+            }
+            EXPECT_TRUE(mRingBuffer.Write(3));
+        }
+    });
+
+    int expected = 0;
+    uint32_t errors = 0;
+    while (expected < static_cast<int>(blocks * 3)) {
+        int* data = nullptr;
+        size_t size = 1;
+        if (!mRingBuffer.Peek(data, size)) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t i = 0; i < size; i++) {
+            errors += (data[i] != expected++) ? 1 : 0;
+        }
+        EXPECT_TRUE(mRingBuffer.Read(size));
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, 0);
+    EXPECT_EQ(mRingBuffer.Size(), 0);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "ContiguousRingbuffer.hpp"
+
+class TEST_Statistics : public ::testing::Test {
+protected:
+    ContiguousRingbuffer<int, 0, ContiguousRingbufferStatisticsPolicy> mRingBuffer;
+
+    void SetUp() override {
+        EXPECT_TRUE(mRingBuffer.Resize(10));
+        EXPECT_EQ(mRingBuffer.Size(), 0);
+    }
+
+    void TearDown() override
+    {
+        mRingBuffer.Clear();
+    };
+
+    // Helper method to write a block of 'size' elements
+    bool WriteBlock(size_t size) {
+        int* data = nullptr;
+        size_t available = size;
+        return mRingBuffer.Poke(data, available) && mRingBuffer.Write(size);
+    }
+};
+
+TEST_F(TEST_Statistics, InitialState) {
+    const auto statistics = mRingBuffer.Statistics();
+
+    EXPECT_EQ(statistics.peakSize, 0);
+    EXPECT_EQ(statistics.failedWrites, 0);
+    EXPECT_EQ(statistics.failedReads, 0);
+    EXPECT_EQ(statistics.wrapWaste, 0);
+    for (size_t i = 0; i < ContiguousRingbufferStatistics::Buckets; i++) {
+        EXPECT_EQ(statistics.writeSizes[i], 0);
+        EXPECT_EQ(statistics.readSizes[i], 0);
+    }
+}
+
+TEST_F(TEST_Statistics, BlockSizesAndPeak) {
+    EXPECT_TRUE(WriteBlock(3));                             // Bucket 1
+    EXPECT_TRUE(WriteBlock(1));                             // Bucket 0
+    EXPECT_TRUE(WriteBlock(4));                             // Bucket 2
+    EXPECT_TRUE(mRingBuffer.Read(5));                       // Bucket 2
+    EXPECT_TRUE(mRingBuffer.Read(3));                       // Bucket 1
+    EXPECT_TRUE(WriteBlock(2));                             // Bucket 1
+
+    const auto statistics = mRingBuffer.Statistics();
+    EXPECT_EQ(statistics.peakSize, 8);
+    EXPECT_EQ(statistics.writeSizes[0], 1);
+    EXPECT_EQ(statistics.writeSizes[1], 2);
+    EXPECT_EQ(statistics.writeSizes[2], 1);
+    EXPECT_EQ(statistics.readSizes[1], 1);
+    EXPECT_EQ(statistics.readSizes[2], 1);
+    EXPECT_EQ(statistics.failedWrites, 0);
+    EXPECT_EQ(statistics.failedReads, 0);
+}
+
+TEST_F(TEST_Statistics, FailedWritesAndReads) {
+    int* data = nullptr;
+    size_t size = 0;
+    EXPECT_FALSE(mRingBuffer.Poke(data, size));             // Invalid size
+    EXPECT_FALSE(mRingBuffer.Write(11));                    // Invalid size
+
+    size = 1;
+    EXPECT_FALSE(mRingBuffer.Peek(data, size));             // Empty
+    EXPECT_FALSE(mRingBuffer.Read(1));                      // Empty
+
+    EXPECT_TRUE(WriteBlock(10));                            // Full
+    EXPECT_FALSE(WriteBlock(1));
+
+    const auto statistics = mRingBuffer.Statistics();
+    EXPECT_EQ(statistics.failedWrites, 3);
+    EXPECT_EQ(statistics.failedReads, 2);
+    EXPECT_EQ(statistics.peakSize, 10);
+}
+
+TEST_F(TEST_Statistics, WrapWaste) {
+    EXPECT_TRUE(WriteBlock(8));
+    EXPECT_TRUE(mRingBuffer.Read(8));
+
+    EXPECT_TRUE(WriteBlock(5));                             // Does not fit at the end, 3 elements skipped
+    EXPECT_TRUE(mRingBuffer.CheckState(5, 8, 8));
+
+    auto statistics = mRingBuffer.Statistics();
+    EXPECT_EQ(statistics.wrapWaste, 3);
+    EXPECT_EQ(statistics.peakSize, 8);
+
+    EXPECT_TRUE(mRingBuffer.Read(5));
+    EXPECT_TRUE(WriteBlock(5));                             // Fits at the end, nothing skipped
+
+    statistics = mRingBuffer.Statistics();
+    EXPECT_EQ(statistics.wrapWaste, 3);
+}
+
+TEST_F(TEST_Statistics, LargeBlocksInLastBucket) {
+    EXPECT_TRUE(mRingBuffer.Resize(100000));
+    EXPECT_TRUE(WriteBlock(70000));
+    EXPECT_TRUE(mRingBuffer.Read(70000));
+
+    const auto statistics = mRingBuffer.Statistics();
+    EXPECT_EQ(statistics.writeSizes[ContiguousRingbufferStatistics::Buckets - 1], 1);
+    EXPECT_EQ(statistics.readSizes[ContiguousRingbufferStatistics::Buckets - 1], 1);
+}
+
+TEST_F(TEST_Statistics, Reset) {
+    EXPECT_TRUE(WriteBlock(4));
+    EXPECT_FALSE(mRingBuffer.Read(5));
+
+    mRingBuffer.Clear();                                    // Statistics are kept
+    EXPECT_EQ(mRingBuffer.Statistics().peakSize, 4);
+
+    mRingBuffer.ResetStatistics();
+    EXPECT_EQ(mRingBuffer.Statistics().peakSize, 0);
+    EXPECT_EQ(mRingBuffer.Statistics().writeSizes[2], 0);
+    EXPECT_EQ(mRingBuffer.Statistics().failedReads, 0);
+
+    EXPECT_TRUE(WriteBlock(4));
+    EXPECT_TRUE(mRingBuffer.Resize(10));                    // Resize() resets the statistics
+    EXPECT_EQ(mRingBuffer.Statistics().peakSize, 0);
+}
+
+TEST(TEST_StatisticsStaticCapacity, BlockSizesAndPeak) {
+    ContiguousRingbuffer<int, 10, ContiguousRingbufferStatisticsPolicy> buffer;
+
+    int* data = nullptr;
+    size_t size = 6;
+    EXPECT_TRUE(buffer.Poke(data, size));
+    EXPECT_TRUE(buffer.Write(6));                           // Bucket 2
+    EXPECT_TRUE(buffer.Read(2));                            // Bucket 1
+    EXPECT_FALSE(buffer.Read(5));
+
+    const auto statistics = buffer.Statistics();
+    EXPECT_EQ(statistics.peakSize, 6);
+    EXPECT_EQ(statistics.writeSizes[2], 1);
+    EXPECT_EQ(statistics.readSizes[1], 1);
+    EXPECT_EQ(statistics.failedReads, 1);
+}
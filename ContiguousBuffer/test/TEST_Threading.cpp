@@ -130,3 +130,19 @@ TEST_F(TEST_Threading, ThreadingOperations)
     Threaded_Iteration(buffer_size, nrOfRuns, 1, 4);
     Threaded_Iteration(buffer_size, nrOfRuns, 4, 4);
 }
+
+TEST_F(TEST_Threading, ThreadingResetByPoke)
+{
+    // Fill the reference array with 'known' values
+    for (auto i = 0; i < NR_ITEMS_THREAD_TEST; i++)
+    {
+        refArr[i] = i;
+    }
+
+    const uint16_t nrOfRuns = 200;
+
+    // Block size equals buffer size: Poke() resets mWrite and mRead on every block
+    Threaded_Iteration(4, nrOfRuns, 4, 4);
+    Threaded_Iteration(5, nrOfRuns, 5, 5);
+    Threaded_Iteration(5, nrOfRuns, 5, 1);
+}
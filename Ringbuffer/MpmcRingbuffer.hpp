@@ -0,0 +1,484 @@
+/**
+ * \file    MpmcRingbuffer.hpp
+ * \brief   Header file for the MpmcRingbuffer class.
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ * \class   MpmcRingbuffer
+ *
+ * \brief   Multi-Producer, Multi-Consumer, lock-free, bounded ring buffer.
+ *
+ * \details Every slot holds a sequence number next to the element, after
+ *          Dmitry Vyukov's bounded MPMC queue. The sequence tells whether the
+ *          slot is free or filled for the current lap, so a producer (or
+ *          consumer) only needs a single CAS on the write (or read) position
+ *          to claim slots. The positions are free running, the slot is the
+ *          position modulo the capacity.
+ *
+ *          The interface follows Ringbuffer: 'Resize()', 'TryPush()',
+ *          'TryPop()' and 'Size()'. Where only one producer and one consumer
+ *          are used, Ringbuffer is faster.
+ *
+ * \remarks A thread which is preempted between claiming and publishing a
+ *          slot delays the threads on the other side for that slot only.
+ *          A claimed slot must always be published, else the consumers
+ *          stall on it forever: constructing an element may not throw.
+ *
+ * \note    http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef MPMC_RING_BUFFER_HPP_
+#define MPMC_RING_BUFFER_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     RINGBUFFER_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the producer and
+ *          consumer positions. Override for the target if needed.
+ */
+#ifndef RINGBUFFER_CACHE_LINE_SIZE
+#define RINGBUFFER_CACHE_LINE_SIZE      64
+#endif // RINGBUFFER_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename T>
+class MpmcRingbuffer
+{
+public:
+    MpmcRingbuffer() noexcept;
+    ~MpmcRingbuffer();
+
+    bool Resize(const size_t size) noexcept;
+
+    bool TryPush(const T* src, const size_t size = 1);
+    bool TryPush(T&& item);
+    template<typename... Args>
+    bool TryEmplace(Args&&... args);
+
+    bool TryPop(T* &dest, const size_t size = 1);
+    bool TryPop(T& item);
+
+    size_t Size() const;
+    size_t Capacity() const;
+
+    void Clear();
+
+    bool IsLockFree() const;
+
+private:
+    static constexpr size_t Alignment = (RINGBUFFER_CACHE_LINE_SIZE > alignof(std::atomic<size_t>)) ?
+                                         RINGBUFFER_CACHE_LINE_SIZE : alignof(std::atomic<size_t>);
+
+    struct Slot
+    {
+        std::atomic<size_t> sequence{0};                        // Position the slot is ready for
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;   // Raw, unconstructed element
+    };
+
+    alignas(Alignment) std::atomic<size_t> mWrite{0};           // Shared by producers
+    alignas(Alignment) std::atomic<size_t> mRead{0};            // Shared by consumers
+
+    alignas(Alignment) size_t mCapacity{0};                     // Read-only after Resize()
+    std::unique_ptr<Slot[]> mSlots{nullptr};
+
+    inline bool   ClaimWrite(const size_t size, size_t& position);
+    inline bool   ClaimRead(const size_t size, size_t& position);
+    inline Slot&  SlotAt(const size_t position) const;
+    inline T*     Element(Slot& slot) const;
+    void DeleteBuffer();
+};
+
+
+/**
+ * \brief Default constructor.
+ * \details Initializes an empty ring buffer. Call 'Resize()' to set the buffer size.
+ */
+template<typename T>
+MpmcRingbuffer<T>::MpmcRingbuffer() noexcept :
+    mWrite(0), mRead(0), mCapacity(0), mSlots(nullptr)
+{ }
+
+/**
+ * \brief Destructor that destroys the remaining elements and frees the buffer memory.
+ */
+template<typename T>
+MpmcRingbuffer<T>::~MpmcRingbuffer()
+{
+    DeleteBuffer();
+}
+
+/**
+ * \brief   Resizes the buffer to the specified size.
+ * \details Destroys the elements in the buffer, frees any existing memory and
+ *          allocates a new buffer of the requested size. No additional element
+ *          is needed, the sequence numbers distinguish between full and empty.
+ * \param   size    The desired size of the buffer.
+ * \return  True if the buffer was successfully resized; otherwise, false.
+ *          Returns false if the requested size is zero or if allocation fails.
+ * \note    This operation is not thread-safe.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::Resize(const size_t size) noexcept
+{
+    if (size == 0)
+    {
+        return false;                                           // Invalid size
+    }
+
+    DeleteBuffer();                                             // Destroy elements, free existing memory
+
+    mSlots = std::unique_ptr<Slot[]>(new(std::nothrow) Slot[size]);
+
+    if (!mSlots)
+    {
+        return false;                                           // Allocation failed
+    }
+
+    mCapacity = size;
+    Clear();                                                    // Reset positions and sequences
+
+    return true;                                                // Successfully resized
+}
+
+/**
+ * \brief   Tries to copy 'size' elements from 'src' into the buffer.
+ * \details The elements are claimed with a single CAS and are stored
+ *          consecutively. Each element becomes visible to the consumers as
+ *          soon as its slot is published. Requires a nothrow copy constructor.
+ * \returns True if all elements could be copied into the buffer; false if:
+ *          - 'size' is 0 or larger than buffer capacity,
+ *          - 'size' exceeds the remaining space,
+ *          - 'src' is nullptr.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::TryPush(const T* src, const size_t size)
+{
+    static_assert(std::is_nothrow_copy_constructible<T>::value, "A claimed slot must be published, copying may not throw");
+
+    if (size == 0 || size > mCapacity || src == nullptr)
+    {
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    size_t position;
+    if (!ClaimWrite(size, position))
+    {
+        return false;                                           // Not enough space
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        Slot& slot = SlotAt(position + i);
+        new (Element(slot)) T(src[i]);
+        slot.sequence.store(position + i + 1, std::memory_order_release);   // Publish to consumers
+    }
+    return true;
+}
+
+/**
+ * \brief Tries to move a single element into the buffer.
+ * \param item The element to move into the buffer.
+ * \returns True if the element was moved into the buffer; false if the buffer is full.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::TryPush(T&& item)
+{
+    return TryEmplace(std::move(item));
+}
+
+/**
+ * \brief Tries to construct a single element in place in the buffer.
+ * \details Requires a constructor which does not throw for 'args'.
+ * \param args The arguments passed to the constructor of the element.
+ * \returns True if the element was constructed in the buffer; false if the buffer is full.
+ */
+template<typename T>
+template<typename... Args>
+bool MpmcRingbuffer<T>::TryEmplace(Args&&... args)
+{
+    static_assert(std::is_nothrow_constructible<T, Args&&...>::value, "A claimed slot must be published, constructing may not throw");
+
+    size_t position;
+    if (mCapacity == 0 || !ClaimWrite(1, position))
+    {
+        return false;                                           // Not enough space
+    }
+
+    Slot& slot = SlotAt(position);
+    new (Element(slot)) T(std::forward<Args>(args)...);
+    slot.sequence.store(position + 1, std::memory_order_release);   // Publish to consumers
+    return true;
+}
+
+/**
+ * \brief   Tries to retrieve 'size' elements from the buffer to 'dest'.
+ * \details The elements are claimed with a single CAS, moved to 'dest' and
+ *          destroyed in the buffer. Each slot is handed back to the producers
+ *          as soon as its element is moved.
+ * \returns True if all elements could be moved into 'dest'; false if:
+ *          - 'size' is 0 or larger than buffer capacity,
+ *          - 'size' exceeds the number of available elements,
+ *          - 'dest' is nullptr.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::TryPop(T* &dest, const size_t size)
+{
+    if (size == 0 || size > mCapacity || dest == nullptr)
+    {
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    size_t position;
+    if (!ClaimRead(size, position))
+    {
+        return false;                                           // Not enough elements available
+    }
+
+    for (size_t i = 0; i < size; i++)
+    {
+        Slot& slot = SlotAt(position + i);
+        T* element = Element(slot);
+        dest[i] = std::move(*element);
+        element->~T();
+        slot.sequence.store(position + i + mCapacity, std::memory_order_release);  // Free for the next lap
+    }
+    return true;
+}
+
+/**
+ * \brief Tries to move a single element out of the buffer.
+ * \param item Reference to store the retrieved element.
+ * \returns True if an element was retrieved; false if the buffer is empty.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::TryPop(T& item)
+{
+    size_t position;
+    if (mCapacity == 0 || !ClaimRead(1, position))
+    {
+        return false;                                           // Buffer is empty
+    }
+
+    Slot& slot = SlotAt(position);
+    T* element = Element(slot);
+    item = std::move(*element);
+    element->~T();
+    slot.sequence.store(position + mCapacity, std::memory_order_release);  // Free for the next lap
+    return true;
+}
+
+/**
+ * \brief   Returns the number of elements in the buffer.
+ * \remark  This is a snapshot; claimed elements which are not yet published
+ *          (or not yet moved out) are counted as well.
+ * \return  The total number of elements currently in the buffer.
+ */
+template<typename T>
+size_t MpmcRingbuffer<T>::Size() const
+{
+    const auto read  = mRead.load(std::memory_order_acquire);
+    const auto write = mWrite.load(std::memory_order_acquire);
+
+    return (write > read) ? (write - read) : 0;                 // Read may pass a stale write
+}
+
+/**
+ * \brief   Returns the capacity of the buffer.
+ * \return  The number of elements that can be stored in the buffer.
+ */
+template<typename T>
+size_t MpmcRingbuffer<T>::Capacity() const
+{
+    return mCapacity;
+}
+
+/**
+ * \brief   Clears the buffer by resetting the positions and sequences.
+ * \details The elements in the buffer are destroyed, the memory remains allocated
+ *          until the buffer is resized or destructed.
+ * \note    This operation is not thread-safe.
+ */
+template<typename T>
+void MpmcRingbuffer<T>::Clear()
+{
+    const auto write = mWrite.load(std::memory_order_acquire);
+
+    for (auto position = mRead.load(std::memory_order_acquire); position != write; position++)
+    {
+        Slot& slot = SlotAt(position);
+        if (slot.sequence.load(std::memory_order_acquire) == (position + 1))
+        {
+            Element(slot)->~T();                                // Only destroy published elements
+        }
+    }
+
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    mWrite.store(0, std::memory_order_release);
+    mRead.store(0, std::memory_order_release);
+}
+
+/**
+ * \brief   Check if atomic operations in the buffer are truly lock-free.
+ * \result  Returns true if the atomic operations are lock-free, else false.
+ */
+template<typename T>
+bool MpmcRingbuffer<T>::IsLockFree() const
+{
+    return (mWrite.is_lock_free() && mRead.is_lock_free());
+}
+
+/************************************************************************/
+/* Private Members                                                      */
+/************************************************************************/
+/**
+ * \brief   Claims 'size' consecutive slots for writing.
+ * \details All slots must be free for the current lap before the write
+ *          position is advanced with a single CAS. A slot ahead of the
+ *          position means another producer claimed it: retry from the new
+ *          position. A slot behind means it is not consumed yet: full.
+ * \param   size        The number of slots to claim.
+ * \param   position    Updated to the first claimed position.
+ * \return  True if the slots are claimed, false if there is not enough space.
+ */
+template<typename T>
+inline bool MpmcRingbuffer<T>::ClaimWrite(const size_t size, size_t& position)
+{
+    position = mWrite.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        bool free = true;
+        for (size_t i = 0; i < size && free; i++)
+        {
+            const auto sequence = SlotAt(position + i).sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - (position + i));
+
+            if (diff < 0)
+            {
+                return false;                                   // Not consumed yet: buffer full
+            }
+            free = (diff == 0);
+        }
+
+        if (free)
+        {
+            if (mWrite.compare_exchange_weak(position, position + size, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            position = mWrite.load(std::memory_order_relaxed);  // Claimed by another producer
+        }
+    }
+}
+
+/**
+ * \brief   Claims 'size' consecutive slots for reading.
+ * \details All slots must be published for the current lap before the read
+ *          position is advanced with a single CAS.
+ * \param   size        The number of slots to claim.
+ * \param   position    Updated to the first claimed position.
+ * \return  True if the slots are claimed, false if there are not enough elements.
+ */
+template<typename T>
+inline bool MpmcRingbuffer<T>::ClaimRead(const size_t size, size_t& position)
+{
+    position = mRead.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        bool filled = true;
+        for (size_t i = 0; i < size && filled; i++)
+        {
+            const auto sequence = SlotAt(position + i).sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - (position + i + 1));
+
+            if (diff < 0)
+            {
+                return false;                                   // Not published yet: buffer empty
+            }
+            filled = (diff == 0);
+        }
+
+        if (filled)
+        {
+            if (mRead.compare_exchange_weak(position, position + size, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            position = mRead.load(std::memory_order_relaxed);   // Claimed by another consumer
+        }
+    }
+}
+
+/**
+ * \brief   Returns the slot for the given position.
+ * \param   position    The free running read or write position.
+ * \return  Reference to the slot.
+ */
+template<typename T>
+inline typename MpmcRingbuffer<T>::Slot& MpmcRingbuffer<T>::SlotAt(const size_t position) const
+{
+    return mSlots[position % mCapacity];
+}
+
+/**
+ * \brief   Returns the element stored in the given slot.
+ * \param   slot    The slot.
+ * \return  Pointer to the (possibly unconstructed) element.
+ */
+template<typename T>
+inline T* MpmcRingbuffer<T>::Element(Slot& slot) const
+{
+    return reinterpret_cast<T*>(&slot.storage);
+}
+
+/**
+ * \brief   Delete the buffer, set pointer to nullptr.
+ * \details Destroys the remaining elements first. No effect when buffer already deleted.
+ */
+template<typename T>
+void MpmcRingbuffer<T>::DeleteBuffer()
+{
+    if (mSlots)
+    {
+        Clear();                                                // Destroy the remaining elements
+    }
+
+    mSlots.reset();
+    mCapacity = 0;
+}
+
+#endif // MPMC_RING_BUFFER_HPP_
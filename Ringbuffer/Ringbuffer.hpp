@@ -12,11 +12,32 @@
  * \brief   Single-Producer, Single-Consumer, lock-free, wait-free ring buffer.
  *          Suited for embedded use, see URLs below.
  *
+ * \details The layout of the administration is selected with a policy.
+ *          By default the write index, the read index and the read-only
+ *          metadata each occupy their own cache line, preventing the
+ *          producer and consumer from invalidating each others cache line
+ *          (false sharing). Use 'RingbufferPackedPolicy' to keep the
+ *          original, compact layout (i.e. on a Cortex-M4 without data cache).
+ *          Use 'RingbufferPowerOfTwoPolicy' for a power of two capacity with
+ *          free running indices, wrapped with a mask instead of a modulo.
+ *
+ *          Elements are constructed in raw storage when pushed and destroyed
+ *          when popped, so non-trivially-copyable types (i.e. std::vector)
+ *          can be moved in and out without constructing the whole capacity.
+ *
+ *          On Linux 'RingbufferBlockingPolicy' adds blocking 'Push()' and
+ *          'Pop()' variants, which spin briefly and then sleep on a futex
+ *          until the other side signals progress.
+ *
+ *          'RingbufferStatisticsPolicy' collects statistics for sizing the
+ *          buffer, see 'Statistics()'. Without it the counters are compiled
+ *          out.
+ *
  * \note    https://github.com/tlouwers/embedded/tree/master/Ringbuffer
  *
  * \author  Terry Louwers (terry.louwers@fourtress.nl)
- * \version 1.2
- * \date    03-2025
+ * \version 1.5
+ * \date    10-2026
  */
 
 #ifndef RING_BUFFER_HPP_
@@ -26,9 +47,23 @@
  * Includes                                                                   *
  *****************************************************************************/
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../Allocation/AllocationPolicy.hpp"
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
 
 #ifdef DEBUG
 #include <iostream>
@@ -36,9 +71,117 @@
 
 
 /******************************************************************************
- * Template Class                                                             *
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     RINGBUFFER_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the producer and
+ *          consumer administration. Override for the target if needed.
+ */
+#ifndef RINGBUFFER_CACHE_LINE_SIZE
+#define RINGBUFFER_CACHE_LINE_SIZE      64
+#endif // RINGBUFFER_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Policies                                                                   *
+ *****************************************************************************/
+/**
+ * \struct  RingbufferPolicy
+ * \brief   Default policy: write index, read index and read-only metadata
+ *          are placed on separate cache lines.
+ */
+struct RingbufferPolicy
+{
+    static constexpr size_t CacheLineSize = RINGBUFFER_CACHE_LINE_SIZE;
+    static constexpr bool   PowerOfTwo    = false;
+    static constexpr bool   Blocking      = false;
+    static constexpr size_t SpinCount     = 100;
+    static constexpr bool   Statistics    = false;
+};
+
+/**
+ * \struct  RingbufferPackedPolicy
+ * \brief   Compact policy: administration is packed together, no padding.
+ */
+struct RingbufferPackedPolicy : RingbufferPolicy
+{
+    static constexpr size_t CacheLineSize = 0;
+};
+
+/**
+ * \struct  RingbufferPowerOfTwoPolicy
+ * \brief   Power of two policy: the capacity must be a power of two, the
+ *          indices are free running and wrapped with a mask. No additional
+ *          element is needed to distinguish between full and empty.
+ */
+struct RingbufferPowerOfTwoPolicy : RingbufferPolicy
+{
+    static constexpr bool   PowerOfTwo    = true;
+};
+
+/**
+ * \struct  RingbufferBlockingPolicy
+ * \brief   Blocking policy: enables 'Push()' and 'Pop()', which wait for
+ *          space or elements. Every push and pop checks (after a fence) if
+ *          the other side is waiting, the wake up is skipped if not.
+ *          SpinCount is the number of attempts before going to sleep.
+ * \note    Linux only, a futex is used to sleep and wake up.
+ */
+struct RingbufferBlockingPolicy : RingbufferPolicy
+{
+    static constexpr bool   Blocking      = true;
+};
+
+/**
+ * \struct  RingbufferStatisticsPolicy
+ * \brief   Statistics policy: counts the peak fill level, the failed pushes
+ *          and pops and the distribution of the block sizes. Each side only
+ *          updates its own counters, with relaxed atomics.
+ */
+struct RingbufferStatisticsPolicy : RingbufferPolicy
+{
+    static constexpr bool   Statistics    = true;
+};
+
+
+/******************************************************************************
+ * Typedefs                                                                   *
  *****************************************************************************/
+/**
+ * \struct  RingbufferSpan
+ * \brief   A contiguous block of elements inside the buffer.
+ */
 template<typename T>
+struct RingbufferSpan
+{
+    T*     data  /** Pointer to the first element of the block */  = nullptr;
+    size_t size  /** Number of elements in the block */            = 0;
+};
+
+/**
+ * \struct  RingbufferStatistics
+ * \brief   Snapshot of the statistics, requires a statistics policy.
+ * \details Block sizes are counted per power of two: bucket i holds the
+ *          blocks of 2^i up to 2^(i+1) - 1 elements, the last bucket holds
+ *          all larger blocks.
+ */
+struct RingbufferStatistics
+{
+    static constexpr size_t Buckets = 16;
+
+    size_t peakSize{0};                                         // Highest number of elements after a push
+    size_t failedPushes{0};                                     // Pushes and reservations which failed
+    size_t failedPops{0};                                       // Pops and peeks which failed
+    size_t pushSizes[Buckets]{};                                // Blocks pushed, per power of two
+    size_t popSizes[Buckets]{};                                 // Blocks popped, per power of two
+};
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename T, typename Policy = RingbufferPolicy>
 class Ringbuffer
 {
 public:
@@ -46,9 +189,34 @@ public:
     ~Ringbuffer();
 
     bool Resize(const size_t size) noexcept;
+    bool Resize(const size_t size, const AllocationPolicy& policy) noexcept;
 
     bool TryPush(const T* src, const size_t size = 1);
+    bool TryPush(T&& item);
+    template<typename... Args>
+    bool TryEmplace(Args&&... args);
+
     bool TryPop(T* &dest, const size_t size = 1);
+    bool TryPop(T& item);
+
+    size_t TryPushUpTo(const T* src, const size_t maxSize);
+    size_t TryPopUpTo(T* &dest, const size_t maxSize);
+
+#if defined(__linux__)
+    bool Push(const T* src, const size_t size = 1);
+    template<typename Rep, typename Period>
+    bool Push(const T* src, const size_t size, const std::chrono::duration<Rep, Period>& timeout);
+
+    bool Pop(T* &dest, const size_t size = 1);
+    template<typename Rep, typename Period>
+    bool Pop(T* &dest, const size_t size, const std::chrono::duration<Rep, Period>& timeout);
+#endif // __linux__
+
+    bool TryReserve(const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second);
+    bool Commit(const size_t size);
+
+    bool TryPeek(const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second);
+    bool Release(const size_t size);
 
     size_t Size() const;
     size_t Capacity() const;
@@ -57,6 +225,9 @@ public:
 
     bool IsLockFree() const;
 
+    RingbufferStatistics Statistics() const;
+    void ResetStatistics();
+
 #ifdef DEBUG
     void Print() const;
     void SetState(size_t write, size_t read);
@@ -64,12 +235,72 @@ public:
 #endif // DEBUG
 
 private:
-    std::atomic<size_t> mWrite{0};
-    std::atomic<size_t> mRead{0};
-    size_t mCapacity{0};
-    std::unique_ptr<T[]> mElements{nullptr}; // Use unique_ptr for automatic memory management
+    static constexpr size_t Alignment = (Policy::CacheLineSize > alignof(std::atomic<size_t>)) ?
+                                         Policy::CacheLineSize : alignof(std::atomic<size_t>);
+    static constexpr size_t Spare     = Policy::PowerOfTwo ? 0 : 1;   // Element to distinguish full/empty
+
+    struct PushCounters                                         // Producer's statistics, relaxed
+    {
+        std::atomic<size_t> peak{0};
+        std::atomic<size_t> failed{0};
+        std::atomic<size_t> sizes[RingbufferStatistics::Buckets]{};
+    };
+    struct PopCounters                                          // Consumer's statistics, relaxed
+    {
+        std::atomic<size_t> failed{0};
+        std::atomic<size_t> sizes[RingbufferStatistics::Buckets]{};
+    };
+    struct NoCounters { };                                      // Statistics compiled out
+    using PushStatistics = typename std::conditional<Policy::Statistics, PushCounters, NoCounters>::type;
+    using PopStatistics  = typename std::conditional<Policy::Statistics, PopCounters, NoCounters>::type;
+
+    alignas(Alignment) std::atomic<size_t> mWrite{0};           // Owned by producer
+    size_t mReadCache{0};                                       // Producer's last seen read index
+    PushStatistics mPushStatistics;
+    alignas(Alignment) std::atomic<size_t> mRead{0};            // Owned by consumer
+    size_t mWriteCache{0};                                      // Consumer's last seen write index
+    PopStatistics mPopStatistics;
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;  // Raw, unconstructed element
+
+    alignas(Alignment) size_t mCapacity{0};                     // Read-only after Resize()
+    size_t mMask{0};                                            // Only used with a power of two capacity
+    Region<Storage> mElements{nullptr};                         // Use unique_ptr for automatic memory management
+#if defined(__linux__)
+    std::atomic<uint32_t> mDataSignal{0};                       // Futex word, bumped to wake a waiting consumer
+    std::atomic<uint32_t> mSpaceSignal{0};                      // Futex word, bumped to wake a waiting producer
+    std::atomic<uint32_t> mDataWaiting{0};                      // Set while the consumer waits for elements
+    std::atomic<uint32_t> mSpaceWaiting{0};                     // Set while the producer waits for space
+#endif // __linux__
 
+    inline bool   CanWrite(const size_t write, const size_t size);
+    inline bool   CanRead(const size_t read, const size_t size);
+    inline size_t RefreshReadCache(const size_t write, const size_t size);
+    inline size_t RefreshWriteCache(const size_t read, const size_t size);
+    inline size_t FreeSpace(const size_t write, const size_t read) const;
+    inline size_t UsedSpace(const size_t write, const size_t read) const;
+    inline size_t Offset(const size_t index) const;
+    inline size_t Advance(const size_t index, const size_t size) const;
+    inline T*     Element(const size_t offset) const;
+    inline void   Split(const size_t index, const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second) const;
+    void CopyConstruct(const T* src, const RingbufferSpan<T>& first, const RingbufferSpan<T>& second);
+    void Destroy(const size_t index, const size_t size);
     void DeleteBuffer();
+    inline void   NotifyConsumer();
+    inline void   NotifyProducer();
+    void CountPush(PushCounters& counters, const size_t write, const size_t size);
+    void CountPush(NoCounters&, const size_t, const size_t) { }
+    void CountPop(PopCounters& counters, const size_t size);
+    void CountPop(NoCounters&, const size_t) { }
+    template<typename Counters>
+    static void CountFailure(Counters& counters);
+    static void CountFailure(NoCounters&) { }
+    static size_t Bucket(size_t size);
+#if defined(__linux__)
+    template<typename Operation>
+    bool Block(Operation operation, std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting,
+               const std::chrono::steady_clock::time_point* deadline);
+    static void Notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting);
+#endif // __linux__
 };
 
 
@@ -77,37 +308,60 @@ private:
  * \brief Default constructor.
  * \details Initializes an empty ring buffer. Call 'Resize()' to set the buffer size.
  */
-template<typename T>
-Ringbuffer<T>::Ringbuffer() noexcept :
-    mWrite(0), mRead(0), mCapacity(0), mElements(nullptr)
+template<typename T, typename Policy>
+Ringbuffer<T, Policy>::Ringbuffer() noexcept :
+    mWrite(0), mReadCache(0), mRead(0), mWriteCache(0), mCapacity(0), mMask(0), mElements(nullptr)
 { }
 
 /**
- * \brief Destructor that frees the buffer memory.
+ * \brief Destructor that destroys the remaining elements and frees the buffer memory.
  */
-template<typename T>
-Ringbuffer<T>::~Ringbuffer()
+template<typename T, typename Policy>
+Ringbuffer<T, Policy>::~Ringbuffer()
 {
-    // No need to explicitly delete the buffer; unique_ptr handles it
+    DeleteBuffer();
 }
 
 /**
  * \brief   Resizes the buffer to the specified size.
- * \details Frees any existing memory and allocates a new buffer of the requested size.
- *          The buffer allocates one additional element to distinguish between full and empty states.
+ * \details Destroys the elements in the buffer, frees any existing memory and allocates
+ *          a new buffer of the requested size. The elements are not constructed.
+ *          The buffer allocates one additional element to distinguish between full and empty states,
+ *          except with a power of two policy: there the indices are free running.
  * \param   size    The desired size of the buffer (excluding the additional element).
  * \return  True if the buffer was successfully resized; otherwise, false.
- *          Returns false if the requested size is zero or if allocation fails.
+ *          Returns false if the requested size is zero, is not a power of two
+ *          while using a power of two policy, or if allocation fails.
  */
-template<typename T>
-bool Ringbuffer<T>::Resize(const size_t size) noexcept
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Resize(const size_t size) noexcept
+{
+    return Resize(size, AllocationPolicy{});
+}
+
+/**
+ * \brief   Resizes the buffer, allocating the storage according to 'policy'.
+ * \details As 'Resize(size)', for large buffers: the storage can be placed on
+ *          hugepages, bound to a NUMA node and pre-faulted.
+ * \param   size    The desired size of the buffer (excluding the additional element).
+ * \param   policy  How to allocate the storage, see AllocationPolicy.hpp.
+ * \return  True if the buffer was successfully resized; otherwise, false.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Resize(const size_t size, const AllocationPolicy& policy) noexcept
 {
     if (size == 0) {
         return false;                                           // Invalid size
     }
+    if (Policy::PowerOfTwo && ((size & (size - 1)) != 0)) {
+        return false;                                           // Not a power of two
+    }
+
+    DeleteBuffer();                                             // Destroy elements, free existing memory
 
-    mCapacity = size + 1;                                       // +1 for distinguishing full/empty
-    mElements = std::make_unique<T[]>(mCapacity);               // Allocate new buffer
+    mCapacity = size + Spare;                                   // +1 for distinguishing full/empty
+    mMask     = mCapacity - 1;
+    mElements = MakeRegion<Storage>(mCapacity, policy);         // Allocate new buffer
 
     if (!mElements) {
         mCapacity = 0;                                          // Reset capacity if allocation fails
@@ -121,111 +375,482 @@ bool Ringbuffer<T>::Resize(const size_t size) noexcept
 
 /**
  * \brief Tries to copy 'size' elements from 'src' into the buffer.
- * \details Uses std::copy() to copy elements if there is enough space.
+ * \details Copy constructs the elements in place if there is enough space.
  *          Returns true if all elements are copied; false otherwise.
+ *          The read index is only reloaded when the cached copy indicates
+ *          there is not enough space, keeping the consumer's cache line
+ *          off the hot path.
  * \returns True if all elements could be copied into the buffer; false if:
  *          - 'size' is 0 or larger than buffer capacity,
  *          - 'size' exceeds the remaining space,
  *          - 'src' is nullptr.
+ * \remarks When a copy constructor throws, the elements are not published
+ *          and the ones already copied are destroyed.
  */
-template<typename T>
-bool Ringbuffer<T>::TryPush(const T* src, const size_t size)
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryPush(const T* src, const size_t size)
 {
-    if (size == 0 || size >= mCapacity || src == nullptr)
+    if (size == 0 || (size + Spare) > mCapacity || src == nullptr)
     {
+        CountFailure(mPushStatistics);
         return false;                                           // Early exit for invalid conditions
     }
 
     const auto write = mWrite.load(std::memory_order_relaxed);
-    const auto read = mRead.load(std::memory_order_relaxed);
 
-    if (write >= mCapacity)
+    if (!CanWrite(write, size))
     {
-        return false;                                           // Robustness check
+        CountFailure(mPushStatistics);
+        return false;                                           // Not enough space
     }
 
-    size_t available;
-    if (write >= read)                                          // Space at the end
-    {
-        available = (write == read) ? (mCapacity - 1) : (mCapacity - write + read - 1);
-    }
-    else                                                        // Space at the start
-    {
-        available = (read - write - 1);
-    }
+    RingbufferSpan<T> first;
+    RingbufferSpan<T> second;
+    Split(write, size, first, second);
 
-    if (size > available)                                       // Not enough space
-    {
-        return false;
-    }
+    CopyConstruct(src, first, second);
+
+    mWrite.store(Advance(write, size), std::memory_order_release);
+    CountPush(mPushStatistics, Advance(write, size), size);
+    NotifyConsumer();
 
-    const auto available_upto_end = std::min(size, mCapacity - write);
-    std::copy(src, src + available_upto_end, mElements.get() + write);
+    return true;
+}
 
-    if (size > available_upto_end)
+/**
+ * \brief Tries to move a single element into the buffer.
+ * \param item The element to move into the buffer.
+ * \returns True if the element was moved into the buffer; false if the buffer is full.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryPush(T&& item)
+{
+    return TryEmplace(std::move(item));
+}
+
+/**
+ * \brief Tries to construct a single element in place in the buffer.
+ * \param args The arguments passed to the constructor of the element.
+ * \returns True if the element was constructed in the buffer; false if the buffer is full.
+ */
+template<typename T, typename Policy>
+template<typename... Args>
+bool Ringbuffer<T, Policy>::TryEmplace(Args&&... args)
+{
+    const auto write = mWrite.load(std::memory_order_relaxed);
+
+    if (!CanWrite(write, 1))
     {
-        std::copy(src + available_upto_end, src + size, mElements.get());
+        CountFailure(mPushStatistics);
+        return false;                                           // Not enough space
     }
 
-    mWrite.store((write + size) % mCapacity, std::memory_order_release);
+    new (Element(Offset(write))) T(std::forward<Args>(args)...);
+
+    mWrite.store(Advance(write, 1), std::memory_order_release);
+    CountPush(mPushStatistics, Advance(write, 1), 1);
+    NotifyConsumer();
 
     return true;
 }
 
 /**
  * \brief Tries to retrieve 'size' elements from the buffer to 'dest'.
- * \details Uses std::copy() to copy elements if there are enough available.
+ * \details Moves the elements to 'dest' if there are enough available, then
+ *          destroys them in the buffer.
  *          Returns true if all elements are copied; false otherwise.
+ *          The write index is only reloaded when the cached copy indicates
+ *          there are not enough elements, keeping the producer's cache line
+ *          off the hot path.
  * \returns True if all elements could be copied into 'dest'; false if:
  *          - 'size' is 0 or larger than buffer capacity,
  *          - 'size' exceeds the number of available elements,
  *          - 'dest' is nullptr.
  */
-template<typename T>
-bool Ringbuffer<T>::TryPop(T* &dest, const size_t size)
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryPop(T* &dest, const size_t size)
 {
-    if (size == 0 || size >= mCapacity || dest == nullptr)
+    if (size == 0 || (size + Spare) > mCapacity || dest == nullptr)
     {
+        CountFailure(mPopStatistics);
         return false;                                           // Early exit for invalid conditions
     }
 
+    const auto read = mRead.load(std::memory_order_relaxed);
+
+    if (!CanRead(read, size))
+    {
+        CountFailure(mPopStatistics);
+        return false;                                           // Not enough elements available
+    }
+
+    RingbufferSpan<T> first;
+    RingbufferSpan<T> second;
+    Split(read, size, first, second);
+
+    std::move(first.data, first.data + first.size, dest);
+    std::move(second.data, second.data + second.size, dest + first.size);
+
+    Destroy(read, size);
+
+    mRead.store(Advance(read, size), std::memory_order_release);
+    CountPop(mPopStatistics, size);
+    NotifyProducer();
+
+    return true;
+}
+
+/**
+ * \brief Tries to move a single element out of the buffer.
+ * \param item Reference to store the retrieved element.
+ * \returns True if an element was retrieved; false if the buffer is empty.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryPop(T& item)
+{
+    const auto read = mRead.load(std::memory_order_relaxed);
+
+    if (!CanRead(read, 1))
+    {
+        CountFailure(mPopStatistics);
+        return false;                                           // Buffer is empty
+    }
+
+    T* element = Element(Offset(read));
+    item = std::move(*element);
+    element->~T();
+
+    mRead.store(Advance(read, 1), std::memory_order_release);
+    CountPop(mPopStatistics, 1);
+    NotifyProducer();
+
+    return true;
+}
+
+/**
+ * \brief   Copies as many elements as possible, up to 'maxSize', from 'src' into the buffer.
+ * \details All elements are published with a single index update. The read
+ *          index is only reloaded when the cached copy indicates there is less
+ *          space than 'maxSize'.
+ * \param   src     The elements to copy.
+ * \param   maxSize The maximum number of elements to copy.
+ * \returns The number of elements copied into the buffer; 0 if the buffer is
+ *          full, if 'maxSize' is 0 or if 'src' is nullptr.
+ */
+template<typename T, typename Policy>
+size_t Ringbuffer<T, Policy>::TryPushUpTo(const T* src, const size_t maxSize)
+{
+    if (maxSize == 0 || src == nullptr)
+    {
+        CountFailure(mPushStatistics);
+        return 0;                                               // Early exit for invalid conditions
+    }
+
     const auto write = mWrite.load(std::memory_order_relaxed);
+
+    if (!Policy::PowerOfTwo && write >= mCapacity)
+    {
+        CountFailure(mPushStatistics);
+        return 0;                                               // Robustness check
+    }
+
+    const auto size = std::min(maxSize, RefreshReadCache(write, maxSize));
+    if (size == 0)
+    {
+        CountFailure(mPushStatistics);
+        return 0;                                               // Buffer full
+    }
+
+    RingbufferSpan<T> first;
+    RingbufferSpan<T> second;
+    Split(write, size, first, second);
+
+    CopyConstruct(src, first, second);
+
+    mWrite.store(Advance(write, size), std::memory_order_release);
+    CountPush(mPushStatistics, Advance(write, size), size);
+    NotifyConsumer();
+
+    return size;
+}
+
+/**
+ * \brief   Retrieves as many elements as possible, up to 'maxSize', from the buffer to 'dest'.
+ * \details All elements are freed with a single index update, so a consumer
+ *          can drain a burst without probing 'Size()' first. The write index
+ *          is only reloaded when the cached copy indicates there are fewer
+ *          elements than 'maxSize'.
+ * \param   dest    The destination for the elements.
+ * \param   maxSize The maximum number of elements to retrieve.
+ * \returns The number of elements moved into 'dest'; 0 if the buffer is empty,
+ *          if 'maxSize' is 0 or if 'dest' is nullptr.
+ */
+template<typename T, typename Policy>
+size_t Ringbuffer<T, Policy>::TryPopUpTo(T* &dest, const size_t maxSize)
+{
+    if (maxSize == 0 || dest == nullptr)
+    {
+        CountFailure(mPopStatistics);
+        return 0;                                               // Early exit for invalid conditions
+    }
+
     const auto read = mRead.load(std::memory_order_relaxed);
 
-    if (read >= mCapacity)
+    if (!Policy::PowerOfTwo && read >= mCapacity)
     {
-        return false;                                           // Robustness check
+        CountFailure(mPopStatistics);
+        return 0;                                               // Robustness check
     }
 
-    size_t available;
-    if (write > read)                                           // Data at the start
+    const auto size = std::min(maxSize, RefreshWriteCache(read, maxSize));
+    if (size == 0)
     {
-        available = write - read;
+        CountFailure(mPopStatistics);
+        return 0;                                               // Buffer empty
     }
-    else if (write < read)                                      // Data at the end
+
+    RingbufferSpan<T> first;
+    RingbufferSpan<T> second;
+    Split(read, size, first, second);
+
+    std::move(first.data, first.data + first.size, dest);
+    std::move(second.data, second.data + second.size, dest + first.size);
+
+    Destroy(read, size);
+
+    mRead.store(Advance(read, size), std::memory_order_release);
+    CountPop(mPopStatistics, size);
+    NotifyProducer();
+
+    return size;
+}
+
+#if defined(__linux__)
+/**
+ * \brief   Copies 'size' elements from 'src' into the buffer, waits for space if needed.
+ * \details Spins 'Policy::SpinCount' times, then sleeps until the consumer frees
+ *          elements. Requires a blocking policy.
+ * \returns True if all elements were copied into the buffer; false if 'size' is 0
+ *          or larger than buffer capacity, or if 'src' is nullptr.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Push(const T* src, const size_t size)
+{
+    static_assert(Policy::Blocking, "Push() requires a blocking policy");
+
+    if (size == 0 || (size + Spare) > mCapacity || src == nullptr)
     {
-        available = (mCapacity - read) + write;
+        return false;                                           // Would never succeed
     }
-    else
+
+    return Block([&]() { return TryPush(src, size); }, mSpaceSignal, mSpaceWaiting, nullptr);
+}
+
+/**
+ * \brief   Copies 'size' elements from 'src' into the buffer, waits at most 'timeout' for space.
+ * \param   src     The elements to copy.
+ * \param   size    The number of elements to copy.
+ * \param   timeout The maximum time to wait.
+ * \returns True if all elements were copied into the buffer; false if the timeout
+ *          expired, or for the same invalid conditions as 'TryPush()'.
+ */
+template<typename T, typename Policy>
+template<typename Rep, typename Period>
+bool Ringbuffer<T, Policy>::Push(const T* src, const size_t size, const std::chrono::duration<Rep, Period>& timeout)
+{
+    static_assert(Policy::Blocking, "Push() requires a blocking policy");
+
+    if (size == 0 || (size + Spare) > mCapacity || src == nullptr)
     {
-        return false;                                           // Buffer is empty
+        return false;                                           // Would never succeed
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return Block([&]() { return TryPush(src, size); }, mSpaceSignal, mSpaceWaiting, &deadline);
+}
+
+/**
+ * \brief   Retrieves 'size' elements from the buffer to 'dest', waits for elements if needed.
+ * \details Spins 'Policy::SpinCount' times, then sleeps until the producer adds
+ *          elements. Requires a blocking policy.
+ * \returns True if all elements were moved into 'dest'; false if 'size' is 0
+ *          or larger than buffer capacity, or if 'dest' is nullptr.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Pop(T* &dest, const size_t size)
+{
+    static_assert(Policy::Blocking, "Pop() requires a blocking policy");
+
+    if (size == 0 || (size + Spare) > mCapacity || dest == nullptr)
+    {
+        return false;                                           // Would never succeed
+    }
+
+    return Block([&]() { return TryPop(dest, size); }, mDataSignal, mDataWaiting, nullptr);
+}
+
+/**
+ * \brief   Retrieves 'size' elements from the buffer to 'dest', waits at most 'timeout' for elements.
+ * \param   dest    The destination for the elements.
+ * \param   size    The number of elements to retrieve.
+ * \param   timeout The maximum time to wait.
+ * \returns True if all elements were moved into 'dest'; false if the timeout
+ *          expired, or for the same invalid conditions as 'TryPop()'.
+ */
+template<typename T, typename Policy>
+template<typename Rep, typename Period>
+bool Ringbuffer<T, Policy>::Pop(T* &dest, const size_t size, const std::chrono::duration<Rep, Period>& timeout)
+{
+    static_assert(Policy::Blocking, "Pop() requires a blocking policy");
+
+    if (size == 0 || (size + Spare) > mCapacity || dest == nullptr)
+    {
+        return false;                                           // Would never succeed
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return Block([&]() { return TryPop(dest, size); }, mDataSignal, mDataWaiting, &deadline);
+}
+#endif // __linux__
+
+/**
+ * \brief   Reserves free space in the buffer for writing without copying.
+ * \details The free space is returned as up to two contiguous blocks: the
+ *          block up to the end of the buffer and the wrapped block at the
+ *          start. The producer can fill the blocks in place, then call
+ *          'Commit()' to publish the elements. Only available for trivially
+ *          copyable element types, as the elements are not constructed.
+ * \param   size    The minimum number of elements required.
+ * \param   first   Updated to the first block of free space, else empty.
+ * \param   second  Updated to the wrapped block of free space, else empty.
+ * \returns True if at least 'size' elements are free; false if 'size' is 0
+ *          or larger than buffer capacity, or if there is not enough space.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryReserve(const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "In place access requires a trivially copyable element type");
+
+    first  = {};
+    second = {};
+
+    if (size == 0 || (size + Spare) > mCapacity)
+    {
+        CountFailure(mPushStatistics);
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    const auto write = mWrite.load(std::memory_order_relaxed);
+
+    if (!CanWrite(write, size))
+    {
+        CountFailure(mPushStatistics);
+        return false;                                           // Not enough space
+    }
+
+    Split(write, FreeSpace(write, mReadCache), first, second);
+    return true;
+}
+
+/**
+ * \brief   Publishes 'size' elements written in place after 'TryReserve()'.
+ * \param   size    The number of elements to publish.
+ * \returns True if the elements were published; false if 'size' exceeds the
+ *          free space. Returns true if size is 0, as no update occurs.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Commit(const size_t size)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "In place access requires a trivially copyable element type");
+
+    if (size == 0)
+    {
+        return true;                                            // No update is done
     }
 
-    if (size > available)
+    const auto write = mWrite.load(std::memory_order_relaxed);
+
+    if (!CanWrite(write, size))
     {
+        CountFailure(mPushStatistics);
+        return false;                                           // Not enough space
+    }
+
+    mWrite.store(Advance(write, size), std::memory_order_release);
+    CountPush(mPushStatistics, Advance(write, size), size);
+    NotifyConsumer();
+    return true;
+}
+
+/**
+ * \brief   Provides access to the elements in the buffer without copying.
+ * \details The elements are returned as up to two contiguous blocks: the
+ *          block up to the end of the buffer and the wrapped block at the
+ *          start. The consumer can process the blocks in place, then call
+ *          'Release()' to free the elements. Only available for trivially
+ *          copyable element types, as the elements are not destroyed.
+ * \param   size    The minimum number of elements required.
+ * \param   first   Updated to the first block of elements, else empty.
+ * \param   second  Updated to the wrapped block of elements, else empty.
+ * \returns True if at least 'size' elements are available; false if 'size'
+ *          is 0 or larger than buffer capacity, or if there are not enough
+ *          elements.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::TryPeek(const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "In place access requires a trivially copyable element type");
+
+    first  = {};
+    second = {};
+
+    if (size == 0 || (size + Spare) > mCapacity)
+    {
+        CountFailure(mPopStatistics);
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    const auto read = mRead.load(std::memory_order_relaxed);
+
+    if (!CanRead(read, size))
+    {
+        CountFailure(mPopStatistics);
         return false;                                           // Not enough elements available
     }
 
-    const auto available_upto_end = std::min(size, mCapacity - read);
-    std::copy(mElements.get() + read, mElements.get() + (read + available_upto_end), dest);
+    Split(read, UsedSpace(mWriteCache, read), first, second);
+    return true;
+}
+
+/**
+ * \brief   Frees 'size' elements processed in place after 'TryPeek()'.
+ * \param   size    The number of elements to free.
+ * \returns True if the elements were freed; false if 'size' exceeds the
+ *          number of elements. Returns true if size is 0, as no update occurs.
+ */
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::Release(const size_t size)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "In place access requires a trivially copyable element type");
 
-    if (size > available_upto_end)
+    if (size == 0)
     {
-        std::copy(mElements.get(), mElements.get() + (size - available_upto_end), dest + available_upto_end);
+        return true;                                            // No update is done
     }
 
-    mRead.store((read + size) % mCapacity, std::memory_order_release);
+    const auto read = mRead.load(std::memory_order_relaxed);
+
+    if (!CanRead(read, size))
+    {
+        CountFailure(mPopStatistics);
+        return false;                                           // Not enough elements available
+    }
 
+    mRead.store(Advance(read, size), std::memory_order_release);
+    CountPop(mPopStatistics, size);
+    NotifyProducer();
     return true;
 }
 
@@ -235,14 +860,14 @@ bool Ringbuffer<T>::TryPop(T* &dest, const size_t size)
  *          or write operations occur concurrently.
  * \return  The total number of elements currently in the buffer.
  */
-template<typename T>
-size_t Ringbuffer<T>::Size() const
+template<typename T, typename Policy>
+size_t Ringbuffer<T, Policy>::Size() const
 {
     const auto write = mWrite.load(std::memory_order_acquire);
     const auto read  = mRead.load(std::memory_order_acquire);
 
     // Calculate the number of elements based on the positions of write and read
-    return (write >= read) ? (write - read) : (mCapacity - (read - write));
+    return UsedSpace(write, read);
 }
 
 /**
@@ -251,33 +876,92 @@ size_t Ringbuffer<T>::Size() const
  *          in the buffer, excluding one element used to distinguish between full and empty states.
  * \return  The number of elements that can be stored in the buffer.
  */
-template<typename T>
-size_t Ringbuffer<T>::Capacity() const
+template<typename T, typename Policy>
+size_t Ringbuffer<T, Policy>::Capacity() const
 {
-    return mCapacity - 1;
+    return mCapacity - Spare;
 }
 
 /**
  * \brief   Clears the buffer by resetting the read and write pointers.
- * \details The elements remain in memory until they are overwritten or the buffer is destructed.
+ * \details The elements in the buffer are destroyed, the memory remains allocated
+ *          until the buffer is resized or destructed.
+ * \note    This operation is not thread-safe.
  */
-template<typename T>
-void Ringbuffer<T>::Clear()
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::Clear()
 {
+    const auto write = mWrite.load(std::memory_order_acquire);
+    const auto read  = mRead.load(std::memory_order_acquire);
+
+    if (Policy::PowerOfTwo || (write < mCapacity && read < mCapacity))
+    {
+        Destroy(read, UsedSpace(write, read));
+    }
+
     mWrite.store(0, std::memory_order_release);
     mRead.store(0, std::memory_order_release);
+    mReadCache  = 0;
+    mWriteCache = 0;
 }
 
 /**
  * \brief   Check if atomic operations in the buffer are truly lock-free.
  * \result  Returns true if the atomic operations are lock-free, else false.
  */
-template<typename T>
-bool Ringbuffer<T>::IsLockFree() const
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::IsLockFree() const
 {
     return (mWrite.is_lock_free() && mRead.is_lock_free());
 }
 
+/**
+ * \brief   Returns a snapshot of the statistics. Requires a statistics policy.
+ * \details Each counter is updated by one side only, with relaxed atomics,
+ *          so counting adds no contention. The snapshot may be taken from any
+ *          thread, the counters are not mutually consistent then. The peak
+ *          is calculated by the producer after a push, the read index is
+ *          only loaded when the cached one indicates a new peak. Failed
+ *          attempts of the blocking 'Push()' and 'Pop()' are counted too.
+ * \returns The statistics since construction or the last 'ResetStatistics()'.
+ */
+template<typename T, typename Policy>
+RingbufferStatistics Ringbuffer<T, Policy>::Statistics() const
+{
+    static_assert(Policy::Statistics, "Statistics() requires a statistics policy");
+
+    RingbufferStatistics statistics;
+
+    statistics.peakSize     = mPushStatistics.peak.load(std::memory_order_relaxed);
+    statistics.failedPushes = mPushStatistics.failed.load(std::memory_order_relaxed);
+    statistics.failedPops   = mPopStatistics.failed.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < RingbufferStatistics::Buckets; i++)
+    {
+        statistics.pushSizes[i] = mPushStatistics.sizes[i].load(std::memory_order_relaxed);
+        statistics.popSizes[i]  = mPopStatistics.sizes[i].load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+/**
+ * \brief   Resets the statistics. Requires a statistics policy.
+ * \note    This operation is not thread-safe.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::ResetStatistics()
+{
+    static_assert(Policy::Statistics, "ResetStatistics() requires a statistics policy");
+
+    mPushStatistics.peak.store(0, std::memory_order_relaxed);
+    mPushStatistics.failed.store(0, std::memory_order_relaxed);
+    mPopStatistics.failed.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < RingbufferStatistics::Buckets; i++)
+    {
+        mPushStatistics.sizes[i].store(0, std::memory_order_relaxed);
+        mPopStatistics.sizes[i].store(0, std::memory_order_relaxed);
+    }
+}
+
 #ifdef DEBUG
 /**
  * \brief Sets the state of the ring buffer.
@@ -285,13 +969,15 @@ bool Ringbuffer<T>::IsLockFree() const
  * \param read Value to set for mRead.
  * \remarks Use with caution; no checks are performed.
  */
-template<typename T>
-void Ringbuffer<T>::SetState(size_t write, size_t read)
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::SetState(size_t write, size_t read)
 {
     #warning DEBUG method SetState() enabled - use with caution.
 
     mWrite.store(write, std::memory_order_release);
     mRead.store(read, std::memory_order_release);
+    mReadCache  = read;
+    mWriteCache = write;
 }
 
 /**
@@ -300,8 +986,8 @@ void Ringbuffer<T>::SetState(size_t write, size_t read)
  * \param read Value to compare with mRead.
  * \returns True if both states match; otherwise, false.
  */
-template<typename T>
-bool Ringbuffer<T>::CheckState(size_t write, size_t read)
+template<typename T, typename Policy>
+bool Ringbuffer<T, Policy>::CheckState(size_t write, size_t read)
 {
     #warning DEBUG method CheckState() enabled.
 
@@ -312,14 +998,15 @@ bool Ringbuffer<T>::CheckState(size_t write, size_t read)
 /**
  * \brief Prints the contents of the buffer.
  * \details Displays the read and write pointers, the buffer elements, and the current size.
+ * \remarks Prints all slots, intended for trivially copyable element types only.
  */
-template<typename T>
-void Ringbuffer<T>::Print() const
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::Print() const
 {
     std::cout << "Read(" << mRead.load() << "), Write(" << mWrite.load() << "), Elements[";
-    for (size_t i = 0; i < (mCapacity - 1); i++)
+    for (size_t i = 0; i < Capacity(); i++)
     {
-        std::cout << mElements[i] << (i < (mCapacity - 2) ? "|" : "");
+        std::cout << *Element(i) << ((i + 1) < Capacity() ? "|" : "");
     }
     std::cout << "], Size(" << Size() << ")" << std::endl;
 }
@@ -328,15 +1015,423 @@ void Ringbuffer<T>::Print() const
 /************************************************************************/
 /* Private Members                                                      */
 /************************************************************************/
+/**
+ * \brief   Checks if 'size' elements can be written at the given write index.
+ * \details The cached read index is used first, it is only refreshed when it
+ *          indicates there is not enough space.
+ * \param   write   The write index.
+ * \param   size    The number of elements to write.
+ * \return  True if there is enough space, else false.
+ */
+template<typename T, typename Policy>
+inline bool Ringbuffer<T, Policy>::CanWrite(const size_t write, const size_t size)
+{
+    if (!Policy::PowerOfTwo && write >= mCapacity)
+    {
+        return false;                                           // Robustness check
+    }
+
+    return (size <= RefreshReadCache(write, size));
+}
+
+/**
+ * \brief   Checks if 'size' elements can be read at the given read index.
+ * \details The cached write index is used first, it is only refreshed when it
+ *          indicates there are not enough elements.
+ * \param   read    The read index.
+ * \param   size    The number of elements to read.
+ * \return  True if there are enough elements, else false.
+ */
+template<typename T, typename Policy>
+inline bool Ringbuffer<T, Policy>::CanRead(const size_t read, const size_t size)
+{
+    if (!Policy::PowerOfTwo && read >= mCapacity)
+    {
+        return false;                                           // Robustness check
+    }
+
+    return (size <= RefreshWriteCache(read, size));
+}
+
+/**
+ * \brief   Determines the free space at the given write index.
+ * \details The cached read index is only refreshed when it indicates there is
+ *          less space than 'size'.
+ * \param   write   The write index, must be valid.
+ * \param   size    The number of elements the caller wants to write.
+ * \return  The number of elements which can be added to the buffer.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::RefreshReadCache(const size_t write, const size_t size)
+{
+    if (size > FreeSpace(write, mReadCache))                    // Not enough space according to cached read index
+    {
+        mReadCache = mRead.load(std::memory_order_acquire);     // Refresh the cached read index
+    }
+    return FreeSpace(write, mReadCache);
+}
+
+/**
+ * \brief   Determines the number of elements available at the given read index.
+ * \details The cached write index is only refreshed when it indicates there
+ *          are fewer elements than 'size'.
+ * \param   read    The read index, must be valid.
+ * \param   size    The number of elements the caller wants to read.
+ * \return  The number of elements which can be retrieved from the buffer.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::RefreshWriteCache(const size_t read, const size_t size)
+{
+    if (size > UsedSpace(mWriteCache, read))                    // Not enough elements according to cached write index
+    {
+        mWriteCache = mWrite.load(std::memory_order_acquire);   // Refresh the cached write index
+    }
+    return UsedSpace(mWriteCache, read);
+}
+
+/**
+ * \brief   Calculates the free space for the given indices.
+ * \param   write   The write index.
+ * \param   read    The read index.
+ * \return  The number of elements which can be added to the buffer.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::FreeSpace(const size_t write, const size_t read) const
+{
+    if (Policy::PowerOfTwo) {
+        return mCapacity - (write - read);                      // Free running indices
+    }
+    return (write >= read) ? (mCapacity - 1 - (write - read)) : (read - write - 1);
+}
+
+/**
+ * \brief   Calculates the used space for the given indices.
+ * \param   write   The write index.
+ * \param   read    The read index.
+ * \return  The number of elements which can be retrieved from the buffer.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::UsedSpace(const size_t write, const size_t read) const
+{
+    if (Policy::PowerOfTwo) {
+        return write - read;                                    // Free running indices
+    }
+    return (write >= read) ? (write - read) : (mCapacity - read + write);
+}
+
+/**
+ * \brief   Translates an index into an element position in the buffer.
+ * \param   index   The read or write index.
+ * \return  The position of the element the index refers to.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::Offset(const size_t index) const
+{
+    return Policy::PowerOfTwo ? (index & mMask) : index;
+}
+
+/**
+ * \brief   Returns the element at the given position in the buffer.
+ * \param   offset  The position of the element.
+ * \return  Pointer to the (possibly unconstructed) element.
+ */
+template<typename T, typename Policy>
+inline T* Ringbuffer<T, Policy>::Element(const size_t offset) const
+{
+    return reinterpret_cast<T*>(&mElements[offset]);
+}
+
+/**
+ * \brief   Splits a range of elements into the block up to the end of the
+ *          buffer and the wrapped block at the start.
+ * \param   index   The read or write index the range starts at.
+ * \param   size    The number of elements in the range.
+ * \param   first   Updated to the block up to the end of the buffer.
+ * \param   second  Updated to the wrapped block, empty if the range does not wrap.
+ */
+template<typename T, typename Policy>
+inline void Ringbuffer<T, Policy>::Split(const size_t index, const size_t size, RingbufferSpan<T>& first, RingbufferSpan<T>& second) const
+{
+    const auto offset = Offset(index);
+    const auto upto_end = std::min(size, mCapacity - offset);
+
+    first = { Element(offset), upto_end };
+
+    if (size > upto_end)
+    {
+        second = { Element(0), size - upto_end };
+    }
+}
+
+/**
+ * \brief   Advances an index by the given number of elements.
+ * \param   index   The read or write index.
+ * \param   size    The number of elements to advance.
+ * \return  The advanced index, wrapped with a modulo unless the indices
+ *          are free running.
+ */
+template<typename T, typename Policy>
+inline size_t Ringbuffer<T, Policy>::Advance(const size_t index, const size_t size) const
+{
+    return Policy::PowerOfTwo ? (index + size) : ((index + size) % mCapacity);
+}
+
+/**
+ * \brief   Copy constructs elements into the (possibly wrapped) free space.
+ * \details When a copy constructor throws while filling the second block,
+ *          the elements already constructed in the first block are destroyed
+ *          before the exception propagates ('std::uninitialized_copy' takes
+ *          care of the block it is filling).
+ * \param   src     The elements to copy, 'first.size + second.size' of them.
+ * \param   first   The block up to the end of the buffer.
+ * \param   second  The block wrapped to the start of the buffer.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::CopyConstruct(const T* src, const RingbufferSpan<T>& first, const RingbufferSpan<T>& second)
+{
+    struct Rollback
+    {
+        const RingbufferSpan<T>& span;
+        bool done;
+
+        ~Rollback()
+        {
+            for (size_t i = 0; !done && i < span.size; i++)
+            {
+                span.data[i].~T();
+            }
+        }
+    };
+
+    std::uninitialized_copy(src, src + first.size, first.data);
+
+    Rollback rollback = { first, false };                       // Destroys the first block if the second copy throws
+    std::uninitialized_copy(src + first.size, src + first.size + second.size, second.data);
+    rollback.done = true;
+}
+
+/**
+ * \brief   Destroys a range of elements in the buffer.
+ * \details No effect for trivially destructible element types.
+ * \param   index   The read or write index the range starts at.
+ * \param   size    The number of elements in the range.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::Destroy(const size_t index, const size_t size)
+{
+    if (!std::is_trivially_destructible<T>::value && size > 0)
+    {
+        RingbufferSpan<T> first;
+        RingbufferSpan<T> second;
+        Split(index, size, first, second);
+
+        for (size_t i = 0; i < first.size; i++)
+        {
+            first.data[i].~T();
+        }
+        for (size_t i = 0; i < second.size; i++)
+        {
+            second.data[i].~T();
+        }
+    }
+}
+
 /**
  * \brief   Delete the buffer, set pointer to nullptr.
- * \details No effect when buffer already deleted.
+ * \details Destroys the remaining elements first. No effect when buffer already deleted.
  */
-template<class T>
-void Ringbuffer<T>::DeleteBuffer()
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::DeleteBuffer()
 {
-    // No need to explicitly delete the buffer; unique_ptr handles it
+    if (mElements)
+    {
+        Clear();                                                // Destroy the remaining elements
+    }
+
     mElements.reset(); // Resetting unique_ptr to release memory
+    mCapacity = 0;
+    mMask     = 0;
+}
+
+/**
+ * \brief   Wakes up the consumer if it waits for elements.
+ * \details Only with a blocking policy, compiles to nothing otherwise.
+ */
+template<typename T, typename Policy>
+inline void Ringbuffer<T, Policy>::NotifyConsumer()
+{
+#if defined(__linux__)
+    if (Policy::Blocking)
+    {
+        Notify(mDataSignal, mDataWaiting);
+    }
+#endif // __linux__
+}
+
+/**
+ * \brief   Wakes up the producer if it waits for space.
+ * \details Only with a blocking policy, compiles to nothing otherwise.
+ */
+template<typename T, typename Policy>
+inline void Ringbuffer<T, Policy>::NotifyProducer()
+{
+#if defined(__linux__)
+    if (Policy::Blocking)
+    {
+        Notify(mSpaceSignal, mSpaceWaiting);
+    }
+#endif // __linux__
+}
+
+/**
+ * \brief   Counts a block pushed by the producer.
+ * \details Updates the block size distribution and the peak. A new peak
+ *          according to the cached read index is confirmed with the current
+ *          read index, which refreshes the cache.
+ * \param   counters    The producer's statistics.
+ * \param   write       The write index after the push.
+ * \param   size        The number of elements pushed.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::CountPush(PushCounters& counters, const size_t write, const size_t size)
+{
+    if (UsedSpace(write, mReadCache) > counters.peak.load(std::memory_order_relaxed))
+    {
+        mReadCache = mRead.load(std::memory_order_acquire);     // A stale read index overestimates, confirm
+
+        const auto used = UsedSpace(write, mReadCache);
+        if (used > counters.peak.load(std::memory_order_relaxed))
+        {
+            counters.peak.store(used, std::memory_order_relaxed);
+        }
+    }
+
+    auto& bucket = counters.sizes[Bucket(size)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Counts a block popped by the consumer.
+ * \param   counters    The consumer's statistics.
+ * \param   size        The number of elements popped.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::CountPop(PopCounters& counters, const size_t size)
+{
+    auto& bucket = counters.sizes[Bucket(size)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Counts a failed push or pop.
+ * \details Only the owning side updates the counter, so no read-modify-write
+ *          is needed.
+ * \param   counters    The statistics of the failing side.
+ */
+template<typename T, typename Policy>
+template<typename Counters>
+void Ringbuffer<T, Policy>::CountFailure(Counters& counters)
+{
+    counters.failed.store(counters.failed.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+/**
+ * \brief   Returns the bucket of the block size distribution for 'size'.
+ * \param   size    The number of elements, greater than 0.
+ * \return  The power of two of the size, limited to the last bucket.
+ */
+template<typename T, typename Policy>
+size_t Ringbuffer<T, Policy>::Bucket(size_t size)
+{
+    size_t bucket = 0;
+    while ((size > 1) && (bucket < (RingbufferStatistics::Buckets - 1)))
+    {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+#if defined(__linux__)
+/**
+ * \brief   Retries an operation until it succeeds, sleeping on a futex in between.
+ * \details The waiting flag is set before the final attempt; the fence pairs with
+ *          the fence in 'Notify()', so either the attempt sees the other side's
+ *          update, or the other side sees the flag and bumps the signal. The
+ *          signal is sampled before the attempt, so a wake up in between makes
+ *          the futex return immediately.
+ * \param   operation   The non-blocking operation to retry.
+ * \param   signal      The futex word to sleep on.
+ * \param   waiting     The flag telling the other side to wake us up.
+ * \param   deadline    The time to give up, nullptr to wait forever.
+ * \return  True if the operation succeeded, false if the deadline expired.
+ */
+template<typename T, typename Policy>
+template<typename Operation>
+bool Ringbuffer<T, Policy>::Block(Operation operation, std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting,
+                                  const std::chrono::steady_clock::time_point* deadline)
+{
+    for (size_t i = 0; i < Policy::SpinCount; i++)
+    {
+        if (operation())
+        {
+            return true;                                        // Succeeded while spinning
+        }
+    }
+
+    for (;;)
+    {
+        const auto sequence = signal.load(std::memory_order_acquire);
+        waiting.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);    // Publish flag before the attempt
+
+        if (operation())
+        {
+            waiting.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        timespec  timeout  = {};
+        timespec* relative = nullptr;
+
+        if (deadline != nullptr)
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       *deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+            {
+                waiting.store(0, std::memory_order_relaxed);
+                return false;                                   // Timed out
+            }
+
+            timeout.tv_sec  = static_cast<time_t>(remaining / 1000000000);
+            timeout.tv_nsec = static_cast<long>(remaining % 1000000000);
+            relative = &timeout;
+        }
+
+        // Sleeps only if the signal still holds the sampled value
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAIT_PRIVATE, sequence, relative, nullptr, 0);
+    }
+}
+
+/**
+ * \brief   Bumps the signal and wakes up the other side, if it is waiting.
+ * \details The fence orders the preceding index update before reading the
+ *          flag, the system call is skipped when nobody waits.
+ * \param   signal      The futex word the other side sleeps on.
+ * \param   waiting     The flag set by the other side while waiting.
+ */
+template<typename T, typename Policy>
+void Ringbuffer<T, Policy>::Notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);        // Publish index before reading the flag
+
+    if (waiting.load(std::memory_order_relaxed) != 0)
+    {
+        signal.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
 }
+#endif // __linux__
 
 #endif // RING_BUFFER_HPP_
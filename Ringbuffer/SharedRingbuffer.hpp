@@ -0,0 +1,515 @@
+/**
+ * \file    SharedRingbuffer.hpp
+ * \brief   Header file for the SharedRingbuffer class.
+ * \licence "THE BEER-WARE LICENSE" (Revision 42):
+ *          <terry.louwers@fourtress.nl> wrote this file. As long as you retain
+ *          this notice you can do whatever you want with this stuff. If we
+ *          meet some day, and you think this stuff is worth it, you can buy me
+ *          a beer in return.
+ *                                                                Terry Louwers
+ * \class   SharedRingbuffer
+ *
+ * \brief   Single-Producer, Single-Consumer, lock-free ring buffer in shared
+ *          memory, to exchange elements between two processes.
+ *
+ * \details The administration (layout version, element size, capacity, index
+ *          alignment and the indices) and the elements live in a single region, created
+ *          with POSIX shared memory or provided by the caller (i.e. an mmap'ed
+ *          file). One process creates the region, the other attaches to it;
+ *          attaching fails when the layout does not match. After that no
+ *          system calls are needed to exchange elements.
+ *
+ *          The write and read index each occupy their own cache line. The
+ *          indices are free running 64-bit positions, so the layout is the
+ *          same for 32-bit and 64-bit processes. Each process caches the
+ *          index of the other side locally.
+ *
+ * \note    POSIX only. Only trivially copyable element types can be shared,
+ *          pointers inside elements are meaningless in the other process.
+ *
+ * \author  Terry Louwers (terry.louwers@fourtress.nl)
+ * \version 1.1
+ * \date    10-2026
+ */
+
+#ifndef SHARED_RING_BUFFER_HPP_
+#define SHARED_RING_BUFFER_HPP_
+
+/******************************************************************************
+ * Includes                                                                   *
+ *****************************************************************************/
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/******************************************************************************
+ * Defines                                                                    *
+ *****************************************************************************/
+/**
+ * \def     RINGBUFFER_CACHE_LINE_SIZE
+ * \brief   Size of a cache line in bytes, used to separate the producer and
+ *          consumer administration. Override for the target if needed.
+ */
+#ifndef RINGBUFFER_CACHE_LINE_SIZE
+#define RINGBUFFER_CACHE_LINE_SIZE      64
+#endif // RINGBUFFER_CACHE_LINE_SIZE
+
+
+/******************************************************************************
+ * Template Class                                                             *
+ *****************************************************************************/
+template<typename T>
+class SharedRingbuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Shared elements must be trivially copyable");
+
+public:
+    static constexpr uint32_t Magic   = 0x52425546;             // 'RBUF'
+    static constexpr uint32_t Version = 2;                      // Increment on layout changes
+
+    SharedRingbuffer() noexcept;
+    ~SharedRingbuffer();
+
+    SharedRingbuffer(const SharedRingbuffer&) = delete;
+    SharedRingbuffer& operator=(const SharedRingbuffer&) = delete;
+
+    bool Create(const char* name, const size_t size);
+    bool Attach(const char* name);
+
+    bool Create(void* region, const size_t bytes, const size_t size);
+    bool Attach(void* region, const size_t bytes);
+
+    void Detach();
+    static bool Remove(const char* name);
+    static size_t RequiredBytes(const size_t size);
+
+    bool TryPush(const T* src, const size_t size = 1);
+    bool TryPop(T* &dest, const size_t size = 1);
+
+    size_t Size() const;
+    size_t Capacity() const;
+
+    bool IsAttached() const;
+    bool IsLockFree() const;
+
+private:
+    static constexpr size_t Alignment = (RINGBUFFER_CACHE_LINE_SIZE > alignof(std::atomic<uint64_t>)) ?
+                                         RINGBUFFER_CACHE_LINE_SIZE : alignof(std::atomic<uint64_t>);
+
+    /**
+     * \struct  Header
+     * \brief   Administration at the start of the shared region.
+     */
+    struct Header
+    {
+        std::atomic<uint32_t> magic;                            // Written last by the creator
+        uint32_t version;
+        uint64_t elementSize;
+        uint64_t elementAlignment;
+        uint64_t capacity;
+        uint64_t indexAlignment;                                // RINGBUFFER_CACHE_LINE_SIZE of the creator
+        uint64_t elementsOffset;
+        alignas(Alignment) std::atomic<uint64_t> write;         // Owned by producer
+        alignas(Alignment) std::atomic<uint64_t> read;          // Owned by consumer
+    };
+
+    static constexpr size_t ElementsOffset = ((sizeof(Header) + alignof(T) - 1) / alignof(T)) * alignof(T);
+
+    Header*  mHeader{nullptr};
+    T*       mElements{nullptr};
+    uint64_t mCapacity{0};
+    uint64_t mReadCache{0};                                     // Producer's last seen read index
+    uint64_t mWriteCache{0};                                    // Consumer's last seen write index
+    void*    mMapping{nullptr};                                 // Only set when mapped by this class
+    size_t   mMappingBytes{0};
+
+    bool Map(const int fd, const size_t bytes);
+};
+
+
+/**
+ * \brief Default constructor.
+ * \details Initializes a detached ring buffer. Call 'Create()' or 'Attach()' first.
+ */
+template<typename T>
+SharedRingbuffer<T>::SharedRingbuffer() noexcept :
+    mHeader(nullptr), mElements(nullptr), mCapacity(0), mReadCache(0), mWriteCache(0),
+    mMapping(nullptr), mMappingBytes(0)
+{ }
+
+/**
+ * \brief Destructor, unmaps the region. The shared memory object is not removed.
+ */
+template<typename T>
+SharedRingbuffer<T>::~SharedRingbuffer()
+{
+    Detach();
+}
+
+/**
+ * \brief   Creates a POSIX shared memory object holding a buffer of 'size' elements.
+ * \details The object must not exist yet, use 'Remove()' to clean up a stale one.
+ * \param   name    The name of the shared memory object, i.e. "/acquisition".
+ * \param   size    The number of elements in the buffer.
+ * \returns True if the object was created and initialized; otherwise, false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Create(const char* name, const size_t size)
+{
+    if (name == nullptr || size == 0)
+    {
+        return false;                                           // Invalid arguments
+    }
+
+    Detach();
+
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        return false;                                           // Exists already or no access
+    }
+
+    const auto bytes = RequiredBytes(size);
+    const bool mapped = (ftruncate(fd, static_cast<off_t>(bytes)) == 0) && Map(fd, bytes);
+    close(fd);                                                  // The mapping remains valid
+
+    if (!mapped || !Create(mMapping, bytes, size))
+    {
+        Detach();
+        shm_unlink(name);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief   Attaches to an existing POSIX shared memory object.
+ * \param   name    The name of the shared memory object.
+ * \returns True if attached; false if the object does not exist, is not
+ *          initialized yet or has a different layout.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Attach(const char* name)
+{
+    if (name == nullptr)
+    {
+        return false;                                           // Invalid arguments
+    }
+
+    Detach();
+
+    const int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+    {
+        return false;                                           // Does not exist or no access
+    }
+
+    struct stat info;
+    const bool mapped = (fstat(fd, &info) == 0) && Map(fd, static_cast<size_t>(info.st_size));
+    close(fd);
+
+    if (!mapped || !Attach(mMapping, mMappingBytes))
+    {
+        Detach();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief   Creates a buffer of 'size' elements in a region provided by the caller.
+ * \details The region must remain mapped while the buffer is used, and must be
+ *          aligned to a cache line (mmap returns page aligned regions).
+ * \param   region  The start of the region.
+ * \param   bytes   The size of the region, at least 'RequiredBytes(size)'.
+ * \param   size    The number of elements in the buffer.
+ * \returns True if the buffer was initialized; otherwise, false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Create(void* region, const size_t bytes, const size_t size)
+{
+    if (region == nullptr || size == 0 || bytes < RequiredBytes(size) ||
+        (reinterpret_cast<uintptr_t>(region) % Alignment) != 0)
+    {
+        return false;                                           // Invalid arguments
+    }
+
+    auto header = new (region) Header;
+    header->magic.store(0, std::memory_order_relaxed);
+    header->version          = Version;
+    header->elementSize      = sizeof(T);
+    header->elementAlignment = alignof(T);
+    header->capacity         = size;
+    header->indexAlignment   = Alignment;
+    header->elementsOffset   = ElementsOffset;
+    header->write.store(0, std::memory_order_relaxed);
+    header->read.store(0, std::memory_order_relaxed);
+    header->magic.store(Magic, std::memory_order_release);     // Publish the initialized header
+
+    if (region != mMapping)
+    {
+        Detach();
+    }
+    mHeader     = header;
+    mElements   = reinterpret_cast<T*>(static_cast<uint8_t*>(region) + ElementsOffset);
+    mCapacity   = size;
+    mReadCache  = 0;
+    mWriteCache = 0;
+    return true;
+}
+
+/**
+ * \brief   Attaches to a buffer in a region provided by the caller.
+ * \param   region  The start of the region.
+ * \param   bytes   The size of the region.
+ * \returns True if attached; false if the region is not initialized yet, is
+ *          too small or has a different layout version, element size,
+ *          element alignment or index alignment (the creator was built with
+ *          a different RINGBUFFER_CACHE_LINE_SIZE).
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Attach(void* region, const size_t bytes)
+{
+    if (region == nullptr || bytes < sizeof(Header) ||
+        (reinterpret_cast<uintptr_t>(region) % Alignment) != 0)
+    {
+        return false;                                           // Invalid arguments
+    }
+
+    auto header = static_cast<Header*>(region);
+    if (header->magic.load(std::memory_order_acquire) != Magic ||
+        header->version != Version ||
+        header->elementSize != sizeof(T) ||
+        header->elementAlignment != alignof(T) ||
+        header->indexAlignment != Alignment ||
+        header->elementsOffset != ElementsOffset ||
+        header->capacity == 0 ||
+        bytes < RequiredBytes(static_cast<size_t>(header->capacity)))
+    {
+        return false;                                           // Layout mismatch
+    }
+
+    if (region != mMapping)
+    {
+        Detach();
+    }
+    mHeader     = header;
+    mElements   = reinterpret_cast<T*>(static_cast<uint8_t*>(region) + ElementsOffset);
+    mCapacity   = header->capacity;
+    mReadCache  = header->read.load(std::memory_order_acquire);
+    mWriteCache = header->write.load(std::memory_order_acquire);
+    return true;
+}
+
+/**
+ * \brief   Detaches from the buffer, unmaps the region if mapped by 'Create()' or 'Attach()'.
+ */
+template<typename T>
+void SharedRingbuffer<T>::Detach()
+{
+    if (mMapping != nullptr)
+    {
+        munmap(mMapping, mMappingBytes);
+    }
+
+    mHeader       = nullptr;
+    mElements     = nullptr;
+    mCapacity     = 0;
+    mReadCache    = 0;
+    mWriteCache   = 0;
+    mMapping      = nullptr;
+    mMappingBytes = 0;
+}
+
+/**
+ * \brief   Removes the POSIX shared memory object. Processes still attached keep their mapping.
+ * \param   name    The name of the shared memory object.
+ * \returns True if removed; otherwise, false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Remove(const char* name)
+{
+    return (name != nullptr) && (shm_unlink(name) == 0);
+}
+
+/**
+ * \brief   Returns the size of the region needed for a buffer of 'size' elements.
+ * \param   size    The number of elements in the buffer.
+ * \return  The size of the region in bytes.
+ */
+template<typename T>
+size_t SharedRingbuffer<T>::RequiredBytes(const size_t size)
+{
+    return ElementsOffset + size * sizeof(T);
+}
+
+/**
+ * \brief Tries to copy 'size' elements from 'src' into the buffer.
+ * \details Copies the elements if there is enough space.
+ *          Returns true if all elements are copied; false otherwise.
+ * \returns True if all elements could be copied into the buffer; false if:
+ *          - the buffer is not attached,
+ *          - 'size' is 0 or larger than buffer capacity,
+ *          - 'size' exceeds the remaining space,
+ *          - 'src' is nullptr.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::TryPush(const T* src, const size_t size)
+{
+    if (size == 0 || size > mCapacity || src == nullptr)
+    {
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    const auto write = mHeader->write.load(std::memory_order_relaxed);
+
+    if (size > mCapacity - (write - mReadCache))                // Not enough space according to cached read index
+    {
+        mReadCache = mHeader->read.load(std::memory_order_acquire);
+        if (size > mCapacity - (write - mReadCache))
+        {
+            return false;                                       // Not enough space
+        }
+    }
+
+    const auto offset   = static_cast<size_t>(write % mCapacity);
+    const auto upto_end = std::min(size, static_cast<size_t>(mCapacity) - offset);
+
+    std::copy(src, src + upto_end, mElements + offset);
+    std::copy(src + upto_end, src + size, mElements);
+
+    mHeader->write.store(write + size, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * \brief Tries to retrieve 'size' elements from the buffer to 'dest'.
+ * \details Copies the elements to 'dest' if there are enough available.
+ *          Returns true if all elements are copied; false otherwise.
+ * \returns True if all elements could be copied into 'dest'; false if:
+ *          - the buffer is not attached,
+ *          - 'size' is 0 or larger than buffer capacity,
+ *          - 'size' exceeds the number of available elements,
+ *          - 'dest' is nullptr.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::TryPop(T* &dest, const size_t size)
+{
+    if (size == 0 || size > mCapacity || dest == nullptr)
+    {
+        return false;                                           // Early exit for invalid conditions
+    }
+
+    const auto read = mHeader->read.load(std::memory_order_relaxed);
+
+    if (size > mWriteCache - read)                              // Not enough elements according to cached write index
+    {
+        mWriteCache = mHeader->write.load(std::memory_order_acquire);
+        if (size > mWriteCache - read)
+        {
+            return false;                                       // Not enough elements available
+        }
+    }
+
+    const auto offset   = static_cast<size_t>(read % mCapacity);
+    const auto upto_end = std::min(size, static_cast<size_t>(mCapacity) - offset);
+
+    std::copy(mElements + offset, mElements + offset + upto_end, dest);
+    std::copy(mElements, mElements + (size - upto_end), dest + upto_end);
+
+    mHeader->read.store(read + size, std::memory_order_release);
+
+    return true;
+}
+
+/**
+ * \brief   Returns the number of elements in the buffer.
+ * \remark  This is a snapshot; the size may be slightly incorrect if read
+ *          or write operations occur concurrently.
+ * \return  The total number of elements currently in the buffer, 0 if not attached.
+ */
+template<typename T>
+size_t SharedRingbuffer<T>::Size() const
+{
+    if (mHeader == nullptr)
+    {
+        return 0;
+    }
+
+    const auto read  = mHeader->read.load(std::memory_order_acquire);
+    const auto write = mHeader->write.load(std::memory_order_acquire);
+
+    return static_cast<size_t>(write - read);
+}
+
+/**
+ * \brief   Returns the capacity of the buffer.
+ * \return  The number of elements that can be stored in the buffer, 0 if not attached.
+ */
+template<typename T>
+size_t SharedRingbuffer<T>::Capacity() const
+{
+    return static_cast<size_t>(mCapacity);
+}
+
+/**
+ * \brief   Check if the buffer is created or attached.
+ * \result  Returns true if the buffer can be used, else false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::IsAttached() const
+{
+    return (mHeader != nullptr);
+}
+
+/**
+ * \brief   Check if atomic operations in the buffer are truly lock-free.
+ * \details Required for use between processes: a lock would be local to a process.
+ * \result  Returns true if the atomic operations are lock-free, else false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::IsLockFree() const
+{
+    std::atomic<uint64_t> index{0};
+    return index.is_lock_free();
+}
+
+/************************************************************************/
+/* Private Members                                                      */
+/************************************************************************/
+/**
+ * \brief   Maps the shared memory object into this process.
+ * \param   fd      The file descriptor of the shared memory object.
+ * \param   bytes   The number of bytes to map.
+ * \return  True if mapped, else false.
+ */
+template<typename T>
+bool SharedRingbuffer<T>::Map(const int fd, const size_t bytes)
+{
+    if (bytes < sizeof(Header))
+    {
+        return false;                                           // Too small to hold the administration
+    }
+
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mMapping      = mapping;
+    mMappingBytes = bytes;
+    return true;
+}
+
+#endif // SHARED_RING_BUFFER_HPP_
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+#include <cstddef>      // size_t
+#include <chrono>
+#include <thread>
+
+class RingbufferBlockingTest : public ::testing::Test {
+protected:
+    Ringbuffer<int, RingbufferBlockingPolicy> ringBuff;
+    int src[4] = { 1, 2, 3, 4 };
+    int dest[4] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(4));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(RingbufferBlockingTest, InvalidSizes) {
+    int* pNull = nullptr;
+
+    EXPECT_FALSE(ringBuff.Push(pSrc, 0));           // Would block forever
+    EXPECT_FALSE(ringBuff.Push(pSrc, 5));
+    EXPECT_FALSE(ringBuff.Push(nullptr, 1));
+    EXPECT_FALSE(ringBuff.Pop(pDest, 0));
+    EXPECT_FALSE(ringBuff.Pop(pDest, 5));
+    EXPECT_FALSE(ringBuff.Pop(pNull, 1));
+}
+
+TEST_F(RingbufferBlockingTest, NoWaitWhenPossible) {
+    EXPECT_TRUE(ringBuff.Push(pSrc, 4));
+    EXPECT_EQ(ringBuff.Size(), 4);
+    EXPECT_TRUE(ringBuff.Pop(pDest, 4));
+    EXPECT_EQ(ringBuff.Size(), 0);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+TEST_F(RingbufferBlockingTest, TimeoutExpires) {
+    const auto timeout = std::chrono::milliseconds(20);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ringBuff.Pop(pDest, 1, timeout));  // Buffer empty
+    EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
+
+    EXPECT_TRUE(ringBuff.Push(pSrc, 4, timeout));
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ringBuff.Push(pSrc, 1, timeout));  // Buffer full
+    EXPECT_GE(std::chrono::steady_clock::now() - start, timeout);
+
+    EXPECT_TRUE(ringBuff.Pop(pDest, 4, timeout));
+    EXPECT_EQ(ringBuff.Size(), 0);
+}
+
+TEST_F(RingbufferBlockingTest, PopWokenByTryPush) {
+    std::thread producer([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_TRUE(ringBuff.TryPush(pSrc, 2));
+    });
+
+    EXPECT_TRUE(ringBuff.Pop(pDest, 2));            // Sleeps until the producer pushes
+    EXPECT_EQ(dest[0], 1);
+    EXPECT_EQ(dest[1], 2);
+
+    producer.join();
+}
+
+TEST_F(RingbufferBlockingTest, PushWokenByTryPop) {
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 4));
+
+    std::thread consumer([this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_TRUE(ringBuff.TryPop(pDest, 1));
+    });
+
+    EXPECT_TRUE(ringBuff.Push(pSrc, 1));            // Sleeps until the consumer pops
+    EXPECT_EQ(ringBuff.Size(), 4);
+
+    consumer.join();
+}
+
+TEST(RingbufferTestBlocking, ProducerConsumer) {
+    Ringbuffer<size_t, RingbufferBlockingPolicy> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(16));
+
+    const size_t count = 100000;
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_TRUE(ringBuff.Push(&i));
+        }
+    });
+
+    size_t sum = 0;
+    size_t item = 0;
+    size_t* pItem = &item;
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_TRUE(ringBuff.Pop(pItem));
+        EXPECT_EQ(item, i);                         // Order is preserved
+        sum += item;
+    }
+
+    producer.join();
+
+    EXPECT_EQ(sum, count * (count - 1) / 2);
+    EXPECT_EQ(ringBuff.Size(), 0);
+}
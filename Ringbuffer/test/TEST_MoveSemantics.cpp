@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+#include <cstdint>      // uint8_t
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Element type which keeps track of the number of live instances
+struct Counted {
+    static int alive;
+    static int copies;
+    int value;
+
+    Counted() : value(0) { alive++; }
+    explicit Counted(int v) : value(v) { alive++; }
+    Counted(const Counted& other) : value(other.value) { alive++; copies++; }
+    Counted(Counted&& other) noexcept : value(other.value) { other.value = -1; alive++; }
+    Counted& operator=(const Counted& other) { value = other.value; copies++; return *this; }
+    Counted& operator=(Counted&& other) noexcept { value = other.value; other.value = -1; return *this; }
+    ~Counted() { alive--; }
+};
+
+int Counted::alive  = 0;
+int Counted::copies = 0;
+
+class RingbufferMoveSemanticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Counted::alive  = 0;
+        Counted::copies = 0;
+    }
+};
+
+TEST_F(RingbufferMoveSemanticsTest, ResizeDoesNotConstruct) {
+    Ringbuffer<Counted> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(100));
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST_F(RingbufferMoveSemanticsTest, EmplaceAndPop) {
+    Ringbuffer<Counted> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(2));
+
+    EXPECT_TRUE(ringBuff.TryEmplace(1));
+    EXPECT_TRUE(ringBuff.TryEmplace(2));
+    EXPECT_FALSE(ringBuff.TryEmplace(3));               // Buffer full
+    EXPECT_EQ(Counted::alive, 2);
+    EXPECT_EQ(ringBuff.Size(), 2);
+
+    Counted item;
+    EXPECT_TRUE(ringBuff.TryPop(item));
+    EXPECT_EQ(item.value, 1);
+    EXPECT_TRUE(ringBuff.TryPop(item));
+    EXPECT_EQ(item.value, 2);
+    EXPECT_FALSE(ringBuff.TryPop(item));                // Buffer empty
+    EXPECT_EQ(Counted::alive, 1);                       // Only 'item' remains
+    EXPECT_EQ(Counted::copies, 0);
+}
+
+TEST_F(RingbufferMoveSemanticsTest, MoveIn) {
+    Ringbuffer<Counted> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(3));
+
+    Counted item(42);
+    EXPECT_TRUE(ringBuff.TryPush(std::move(item)));
+    EXPECT_EQ(item.value, -1);                          // Moved from
+    EXPECT_EQ(Counted::copies, 0);
+
+    Counted dest[1];
+    Counted* pDest = &dest[0];
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 1));
+    EXPECT_EQ(dest[0].value, 42);
+    EXPECT_EQ(Counted::copies, 0);
+    EXPECT_EQ(Counted::alive, 2);                       // 'item' and 'dest'
+}
+
+TEST_F(RingbufferMoveSemanticsTest, CopyInWithWrap) {
+    Ringbuffer<Counted> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(3));
+    ringBuff.SetState(2, 2);                            // Wrap after 2 elements
+
+    Counted src[3] = { Counted(1), Counted(2), Counted(3) };
+    EXPECT_TRUE(ringBuff.TryPush(src, 3));
+    EXPECT_EQ(Counted::copies, 3);
+    EXPECT_EQ(Counted::alive, 6);
+
+    Counted dest[3];
+    Counted* pDest = &dest[0];
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 3));
+    EXPECT_EQ(dest[0].value, 1);
+    EXPECT_EQ(dest[1].value, 2);
+    EXPECT_EQ(dest[2].value, 3);
+    EXPECT_EQ(Counted::copies, 3);                      // Moved out, not copied
+    EXPECT_EQ(Counted::alive, 6);                       // 'src' and 'dest'
+}
+
+TEST_F(RingbufferMoveSemanticsTest, ClearAndDestructionDestroyElements) {
+    {
+        Ringbuffer<Counted> ringBuff;
+        EXPECT_TRUE(ringBuff.Resize(4));
+
+        EXPECT_TRUE(ringBuff.TryEmplace(1));
+        EXPECT_TRUE(ringBuff.TryEmplace(2));
+        EXPECT_EQ(Counted::alive, 2);
+
+        ringBuff.Clear();
+        EXPECT_EQ(Counted::alive, 0);
+        EXPECT_EQ(ringBuff.Size(), 0);
+
+        EXPECT_TRUE(ringBuff.TryEmplace(3));
+        EXPECT_TRUE(ringBuff.TryEmplace(4));
+        EXPECT_TRUE(ringBuff.Resize(8));                // Resize destroys the elements as well
+        EXPECT_EQ(Counted::alive, 0);
+
+        EXPECT_TRUE(ringBuff.TryEmplace(5));
+        EXPECT_TRUE(ringBuff.TryEmplace(6));
+        EXPECT_EQ(Counted::alive, 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);                       // Destructor destroys the remaining elements
+}
+
+TEST_F(RingbufferMoveSemanticsTest, VectorElements) {
+    Ringbuffer<std::vector<uint8_t>, RingbufferPowerOfTwoPolicy> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(4));
+
+    for (uint8_t i = 1; i <= 10; i++) {
+        std::vector<uint8_t> frame(1000, i);
+        const uint8_t* data = frame.data();
+        EXPECT_TRUE(ringBuff.TryPush(std::move(frame)));
+
+        std::vector<uint8_t> result;
+        EXPECT_TRUE(ringBuff.TryPop(result));
+        EXPECT_EQ(result.size(), 1000);
+        EXPECT_EQ(result[999], i);
+        EXPECT_EQ(result.data(), data);                 // No copy of the frame was made
+    }
+}
+
+TEST_F(RingbufferMoveSemanticsTest, MoveOnlyElements) {
+    Ringbuffer<std::unique_ptr<std::string>> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(2));
+
+    EXPECT_TRUE(ringBuff.TryPush(std::unique_ptr<std::string>(new std::string("first"))));
+    EXPECT_TRUE(ringBuff.TryEmplace(new std::string("second")));
+
+    std::unique_ptr<std::string> item;
+    EXPECT_TRUE(ringBuff.TryPop(item));
+    EXPECT_EQ(*item, "first");
+    EXPECT_TRUE(ringBuff.TryPop(item));
+    EXPECT_EQ(*item, "second");
+    EXPECT_FALSE(ringBuff.TryPop(item));
+}
+
+// Copy constructor throws for the value 'Fail'
+struct ThrowOnCopy : Counted {
+    static constexpr int Fail = 99;
+
+    explicit ThrowOnCopy(int v) : Counted(v) { }
+    ThrowOnCopy(const ThrowOnCopy& other) : Counted(other.value == Fail ? Throw() : other) { }
+
+    static const Counted& Throw() { throw std::runtime_error("copy"); }
+};
+
+TEST_F(RingbufferMoveSemanticsTest, ThrowingCopyWithWrap) {
+    Ringbuffer<ThrowOnCopy> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(4));
+    ringBuff.SetState(3, 3);                            // Wrap after 2 elements
+
+    {
+        ThrowOnCopy src[3] = { ThrowOnCopy(1), ThrowOnCopy(2), ThrowOnCopy(ThrowOnCopy::Fail) };
+        EXPECT_THROW(ringBuff.TryPush(src, 3), std::runtime_error);
+        EXPECT_EQ(Counted::alive, 3);                   // The copies of 1 and 2 are destroyed again
+        EXPECT_EQ(ringBuff.Size(), 0);                  // Nothing published
+
+        EXPECT_THROW(ringBuff.TryPushUpTo(src, 3), std::runtime_error);
+        EXPECT_EQ(Counted::alive, 3);
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
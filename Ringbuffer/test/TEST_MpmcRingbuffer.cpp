@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "MpmcRingbuffer.hpp"
+#include "Ringbuffer.hpp"
+#include <cstddef>      // size_t
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MpmcRingbufferTest : public ::testing::Test {
+protected:
+    MpmcRingbuffer<int> ringBuff;
+    int src[4] = { 1, 2, 3, 4 };
+    int dest[4] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(4));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(MpmcRingbufferTest, Resize) {
+    MpmcRingbuffer<int> buffer;
+    EXPECT_FALSE(buffer.TryPush(pSrc, 1));          // No buffer
+    EXPECT_FALSE(buffer.TryPop(pDest, 1));
+    EXPECT_FALSE(buffer.TryEmplace(1));
+
+    EXPECT_FALSE(ringBuff.Resize(0));
+    EXPECT_TRUE(ringBuff.Resize(3));                // Any size, no additional element
+    EXPECT_EQ(ringBuff.Capacity(), 3);
+    EXPECT_TRUE(ringBuff.IsLockFree());
+}
+
+TEST_F(MpmcRingbufferTest, InvalidSizes) {
+    int* pNull = nullptr;
+
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 0));
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 5));
+    EXPECT_FALSE(ringBuff.TryPush(nullptr, 1));
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 0));
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 5));
+    EXPECT_FALSE(ringBuff.TryPop(pNull, 1));
+}
+
+TEST_F(MpmcRingbufferTest, FillToCapacity) {
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 2));        // Not enough space, nothing is claimed
+    EXPECT_EQ(ringBuff.Size(), 3);
+    EXPECT_TRUE(ringBuff.TryPush(pSrc + 3, 1));
+    EXPECT_EQ(ringBuff.Size(), 4);
+    EXPECT_FALSE(ringBuff.TryEmplace(5));           // Buffer full
+
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 5));
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 4));
+    EXPECT_EQ(ringBuff.Size(), 0);
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 1));        // Buffer empty
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+TEST_F(MpmcRingbufferTest, WrapAround) {
+    for (int lap = 0; lap < 10; lap++) {
+        EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));     // Wraps every lap at another slot
+        EXPECT_TRUE(ringBuff.TryPop(pDest, 3));
+        EXPECT_EQ(dest[0], 1);
+        EXPECT_EQ(dest[1], 2);
+        EXPECT_EQ(dest[2], 3);
+    }
+
+    int item = 0;
+    EXPECT_TRUE(ringBuff.TryPush(42));
+    EXPECT_TRUE(ringBuff.TryPop(item));
+    EXPECT_EQ(item, 42);
+    EXPECT_EQ(ringBuff.Size(), 0);
+}
+
+TEST(MpmcRingbufferTestElements, MoveOnlyTypeAndClear) {
+    MpmcRingbuffer<std::unique_ptr<std::string>> buffer;
+    EXPECT_TRUE(buffer.Resize(4));
+
+    EXPECT_TRUE(buffer.TryPush(std::unique_ptr<std::string>(new std::string("first"))));
+    EXPECT_TRUE(buffer.TryEmplace(new std::string("second")));
+    EXPECT_TRUE(buffer.TryEmplace(new std::string("third")));
+
+    std::unique_ptr<std::string> item;
+    EXPECT_TRUE(buffer.TryPop(item));
+    EXPECT_EQ(*item, "first");
+
+    buffer.Clear();                                 // Destroys the remaining elements
+    EXPECT_EQ(buffer.Size(), 0);
+    EXPECT_FALSE(buffer.TryPop(item));
+}
+
+TEST(MpmcRingbufferTestThreading, ProducersAndConsumers) {
+    MpmcRingbuffer<size_t> buffer;
+    EXPECT_TRUE(buffer.Resize(16));
+
+    const size_t threads = 4;
+    const size_t count   = 20000;                   // Per producer
+
+    std::atomic<size_t> consumedSum{0};
+    std::atomic<size_t> consumedCount{0};
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&buffer, t, count]() {
+            for (size_t i = 0; i < count; i++) {
+                const size_t value[2] = { t * count + i, t * count + i + 1 };
+                const size_t size = ((i % 2) == 0 && (i + 1) < count) ? 2 : 1;   // Mix single and bulk
+                while (!buffer.TryPush(&value[0], size)) { std::this_thread::yield(); }
+                i += size - 1;
+            }
+        });
+        workers.emplace_back([&buffer, &consumedSum, &consumedCount, threads, count]() {
+            size_t item = 0;
+            while (consumedCount.load() < threads * count) {
+                if (buffer.TryPop(item)) {
+                    consumedSum += item;
+                    consumedCount++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    const size_t total = threads * count;
+    EXPECT_EQ(consumedCount.load(), total);
+    EXPECT_EQ(consumedSum.load(), total * (total - 1) / 2);
+    EXPECT_EQ(buffer.Size(), 0);
+}
+
+class MpmcRingbufferTestScaling : public ::testing::Test {
+protected:
+    static constexpr size_t NR_ITEMS    = 200000;   // Total over all producers
+    static constexpr size_t BUFFER_SIZE = 1024;
+
+    // Ringbuffer behind a mutex, the alternative for multiple producers and consumers
+    struct LockedRingbuffer {
+        Ringbuffer<size_t> buffer;
+        std::mutex mutex;
+
+        bool TryPush(const size_t* item) { std::lock_guard<std::mutex> lock(mutex); return buffer.TryPush(item); }
+        bool TryPop(size_t& item)        { std::lock_guard<std::mutex> lock(mutex); return buffer.TryPop(item); }
+    };
+
+    template<typename Buffer>
+    double MeasureThroughput(Buffer& buffer, const size_t pairs) {
+        std::atomic<size_t> consumed{0};
+        std::vector<std::thread> workers;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < pairs; t++) {
+            workers.emplace_back([&buffer, pairs]() {
+                for (size_t i = 0; i < NR_ITEMS / pairs; i++) {
+                    while (!buffer.TryPush(&i)) { std::this_thread::yield(); }
+                }
+            });
+            workers.emplace_back([&buffer, &consumed, pairs]() {
+                size_t item = 0;
+                while (consumed.load(std::memory_order_relaxed) < (NR_ITEMS / pairs) * pairs) {
+                    if (buffer.TryPop(item)) {
+                        consumed.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(consumed.load(), (NR_ITEMS / pairs) * pairs);
+        return consumed.load() / std::chrono::duration<double>(end - start).count();
+    }
+};
+
+TEST_F(MpmcRingbufferTestScaling, LockFreeVersusMutex) {
+#ifndef NDEBUG
+    std::cerr << "Using DEBUG build - results are NOT accurate" << std::endl;
+#endif // NDEBUG
+
+    for (size_t threads = 2; threads <= 16; threads *= 2) {
+        MpmcRingbuffer<size_t> mpmc;
+        EXPECT_TRUE(mpmc.Resize(BUFFER_SIZE));
+        LockedRingbuffer locked;
+        EXPECT_TRUE(locked.buffer.Resize(BUFFER_SIZE));
+
+        const double lockFree = MeasureThroughput(mpmc, threads / 2);
+        const double mutex    = MeasureThroughput(locked, threads / 2);
+
+        std::cerr << threads << " threads: MpmcRingbuffer " << lockFree << " items/sec, "
+                  << "Ringbuffer with mutex " << mutex << " items/sec" << std::endl;
+    }
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+class RingbufferPowerOfTwoTest : public ::testing::Test {
+protected:
+    Ringbuffer<int, RingbufferPowerOfTwoPolicy> ringBuff;
+    int src[4] = { 1, 2, 3, 4 };
+    int dest[4] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(4));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(RingbufferPowerOfTwoTest, Resize) {
+    EXPECT_FALSE(ringBuff.Resize(0));
+    EXPECT_FALSE(ringBuff.Resize(3));
+    EXPECT_FALSE(ringBuff.Resize(6));
+    EXPECT_FALSE(ringBuff.Resize(1000));
+
+    EXPECT_TRUE(ringBuff.Resize(1));
+    EXPECT_EQ(ringBuff.Capacity(), 1);
+    EXPECT_TRUE(ringBuff.Resize(8));
+    EXPECT_EQ(ringBuff.Capacity(), 8);
+    EXPECT_TRUE(ringBuff.Resize(1024));
+    EXPECT_EQ(ringBuff.Capacity(), 1024);
+    EXPECT_EQ(ringBuff.Size(), 0);
+}
+
+TEST_F(RingbufferPowerOfTwoTest, FillToCapacity) {
+    EXPECT_EQ(ringBuff.Capacity(), 4);              // No additional element needed
+
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 0));
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 5));
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 4));
+    EXPECT_EQ(ringBuff.Size(), 4);
+    EXPECT_TRUE(ringBuff.CheckState(4, 0));
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 1));        // Buffer full
+
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 4));
+    EXPECT_EQ(ringBuff.Size(), 0);
+    EXPECT_TRUE(ringBuff.CheckState(4, 4));         // Free running indices
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 1));        // Buffer empty
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+TEST_F(RingbufferPowerOfTwoTest, WrapAround) {
+    ringBuff.SetState(3, 3);                        // Write and read at the last element
+    EXPECT_EQ(ringBuff.Size(), 0);
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));         // 1 element at end, 2 at start
+    EXPECT_TRUE(ringBuff.CheckState(6, 3));
+    EXPECT_EQ(ringBuff.Size(), 3);
+
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 2));
+    EXPECT_EQ(dest[0], 1);
+    EXPECT_EQ(dest[1], 2);
+    EXPECT_TRUE(ringBuff.CheckState(6, 5));
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));
+    EXPECT_EQ(ringBuff.Size(), 4);
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 1));
+
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 4));
+    EXPECT_EQ(dest[0], 3);
+    EXPECT_EQ(dest[1], 1);
+    EXPECT_EQ(dest[2], 2);
+    EXPECT_EQ(dest[3], 3);
+    EXPECT_TRUE(ringBuff.CheckState(9, 9));
+}
+
+TEST_F(RingbufferPowerOfTwoTest, IndexOverflow) {
+    const size_t max = std::numeric_limits<size_t>::max();
+
+    ringBuff.SetState(max - 1, max - 1);            // Indices about to overflow
+    EXPECT_EQ(ringBuff.Size(), 0);
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 4));
+    EXPECT_TRUE(ringBuff.CheckState(2, max - 1));
+    EXPECT_EQ(ringBuff.Size(), 4);
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 1));
+
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 4));
+    EXPECT_TRUE(ringBuff.CheckState(2, 2));
+    EXPECT_EQ(ringBuff.Size(), 0);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+// Micro-benchmark: single threaded push/pop of 3 elements, modulo versus mask
+// based wrapping. Both buffers hold 64 elements; the modulo variant uses 65 slots.
+class RingbufferPowerOfTwoSpeed : public ::testing::Test {
+protected:
+    static const uint32_t NR_OF_RUNS = 5000000;
+
+    template<typename Policy>
+    double Measure() {
+        Ringbuffer<int, Policy> buffer;
+        EXPECT_TRUE(buffer.Resize(64));
+
+        int src[3] = { 1, 2, 3 };
+        int dest[3] = { };
+        int* pDest = &dest[0];
+        bool result = true;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < NR_OF_RUNS; i++) {
+            result &= buffer.TryPush(src, 3);
+            result &= buffer.TryPop(pDest, 3);
+        }
+
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_TRUE(result);
+        EXPECT_EQ(dest[2], 3);
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+};
+
+TEST_F(RingbufferPowerOfTwoSpeed, ModuloVersusMask) {
+    const double modulo = Measure<RingbufferPolicy>();
+    const double mask   = Measure<RingbufferPowerOfTwoPolicy>();
+
+#ifndef NDEBUG
+    std::cerr << "Using DEBUG build - results are NOT accurate" << std::endl;
+#endif // NDEBUG
+
+    std::cerr << "Modulo wrapping: " << modulo << " milliseconds" << std::endl;
+    std::cerr << "Mask wrapping:   " << mask << " milliseconds" << std::endl;
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+
+class RingbufferReserveAndPeekTest : public ::testing::Test {
+protected:
+    Ringbuffer<int> ringBuff;
+    RingbufferSpan<int> first;
+    RingbufferSpan<int> second;
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(5));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(RingbufferReserveAndPeekTest, InvalidSizes) {
+    EXPECT_FALSE(ringBuff.TryReserve(0, first, second));
+    EXPECT_EQ(first.data, nullptr);
+    EXPECT_EQ(first.size, 0);
+    EXPECT_FALSE(ringBuff.TryReserve(6, first, second));
+    EXPECT_FALSE(ringBuff.TryPeek(0, first, second));
+    EXPECT_FALSE(ringBuff.TryPeek(1, first, second));      // Buffer empty
+    EXPECT_FALSE(ringBuff.TryPeek(6, first, second));
+
+    EXPECT_TRUE(ringBuff.Commit(0));                        // No update is done
+    EXPECT_TRUE(ringBuff.Release(0));
+    EXPECT_FALSE(ringBuff.Commit(6));
+    EXPECT_FALSE(ringBuff.Release(1));
+    EXPECT_TRUE(ringBuff.CheckState(0, 0));
+}
+
+TEST_F(RingbufferReserveAndPeekTest, ReserveWithoutWrap) {
+    ringBuff.SetState(0, 0);                                // 5 elements free at end
+    EXPECT_TRUE(ringBuff.TryReserve(2, first, second));
+    EXPECT_NE(first.data, nullptr);
+    EXPECT_EQ(first.size, 5);
+    EXPECT_EQ(second.data, nullptr);
+    EXPECT_EQ(second.size, 0);
+
+    for (int i = 0; i < 3; i++) {
+        first.data[i] = i + 10;
+    }
+    EXPECT_TRUE(ringBuff.Commit(3));
+    EXPECT_TRUE(ringBuff.CheckState(3, 0));
+    EXPECT_EQ(ringBuff.Size(), 3);
+
+    EXPECT_TRUE(ringBuff.TryPeek(3, first, second));
+    EXPECT_EQ(first.size, 3);
+    EXPECT_EQ(second.size, 0);
+    EXPECT_EQ(first.data[0], 10);
+    EXPECT_EQ(first.data[2], 12);
+    EXPECT_FALSE(ringBuff.TryPeek(4, first, second));
+}
+
+TEST_F(RingbufferReserveAndPeekTest, ReserveAndPeekWithWrap) {
+    ringBuff.SetState(4, 4);                                // 2 elements free at end, 3 at start
+    EXPECT_TRUE(ringBuff.TryReserve(5, first, second));
+    EXPECT_EQ(first.size, 2);
+    EXPECT_EQ(second.size, 3);
+    EXPECT_EQ(second.data + 4, first.data);                 // Wrapped block starts at the start of the buffer
+
+    first.data[0]  = 1;
+    first.data[1]  = 2;
+    second.data[0] = 3;
+    second.data[1] = 4;
+    EXPECT_TRUE(ringBuff.Commit(4));
+    EXPECT_TRUE(ringBuff.CheckState(2, 4));
+    EXPECT_EQ(ringBuff.Size(), 4);
+
+    EXPECT_FALSE(ringBuff.TryReserve(2, first, second));    // Only 1 element free
+    EXPECT_FALSE(ringBuff.Commit(2));
+
+    EXPECT_TRUE(ringBuff.TryPeek(1, first, second));
+    EXPECT_EQ(first.size, 2);
+    EXPECT_EQ(second.size, 2);
+    EXPECT_EQ(first.data[0], 1);
+    EXPECT_EQ(first.data[1], 2);
+    EXPECT_EQ(second.data[0], 3);
+    EXPECT_EQ(second.data[1], 4);
+
+    EXPECT_TRUE(ringBuff.Release(3));
+    EXPECT_TRUE(ringBuff.CheckState(2, 1));
+    EXPECT_FALSE(ringBuff.Release(2));
+
+    int dest[1] = { };
+    int* pDest = &dest[0];
+    EXPECT_TRUE(ringBuff.TryPop(pDest));                    // Mixes with copying API
+    EXPECT_EQ(dest[0], 4);
+    EXPECT_EQ(ringBuff.Size(), 0);
+}
+
+TEST_F(RingbufferReserveAndPeekTest, PowerOfTwo) {
+    Ringbuffer<int, RingbufferPowerOfTwoPolicy> buffer;
+    EXPECT_TRUE(buffer.Resize(4));
+
+    buffer.SetState(7, 7);                                  // 1 element free at end, 3 at start
+    EXPECT_TRUE(buffer.TryReserve(4, first, second));
+    EXPECT_EQ(first.size, 1);
+    EXPECT_EQ(second.size, 3);
+    EXPECT_TRUE(buffer.Commit(4));
+    EXPECT_EQ(buffer.Size(), 4);
+
+    EXPECT_TRUE(buffer.TryPeek(4, first, second));
+    EXPECT_EQ(first.size, 1);
+    EXPECT_EQ(second.size, 3);
+    EXPECT_TRUE(buffer.Release(4));
+    EXPECT_TRUE(buffer.CheckState(11, 11));
+}
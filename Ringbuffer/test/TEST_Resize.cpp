@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Ringbuffer.hpp"
+#include <string>
 
 class RingbufferResizeTest : public ::testing::Test {
 protected:
@@ -52,3 +53,28 @@ TEST_F(RingbufferResizeTest, ResizeLargeToSmall) {
     ringBuff.Clear();
     EXPECT_EQ(ringBuff.Size(), 0);
 }
+
+TEST_F(RingbufferResizeTest, ResizeWithAllocationPolicy) {
+    AllocationPolicy policy;
+    policy.pages    = AllocationPolicy::Pages::Transparent;
+    policy.prefault = true;
+
+    EXPECT_FALSE(ringBuff.Resize(0, policy));
+    EXPECT_TRUE(ringBuff.Resize(100000, policy));
+    EXPECT_EQ(ringBuff.Capacity(), 100000);
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));
+    int dest[3] = {};
+    int* pDest = &dest[0];
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 3));
+    EXPECT_EQ(dest[2], 3);
+
+    Ringbuffer<std::string> strings;                    // Elements are destroyed before unmapping
+    EXPECT_TRUE(strings.Resize(1000, policy));
+    std::string text("a string too long for the small string optimization");
+    EXPECT_TRUE(strings.TryPush(&text));
+    EXPECT_TRUE(strings.Resize(10, policy));
+
+    policy.node = 1 << 20;                              // No such NUMA node
+    EXPECT_FALSE(ringBuff.Resize(100, policy));
+}
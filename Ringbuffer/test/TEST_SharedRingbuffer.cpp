@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "SharedRingbuffer.hpp"
+#include <cstddef>      // size_t
+#include <cstdint>      // uint32_t
+#include <string>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+class SharedRingbufferTest : public ::testing::Test {
+protected:
+    std::string name = "/RingbufferTest_" + std::to_string(getpid());
+    SharedRingbuffer<int> producer;
+    SharedRingbuffer<int> consumer;
+    int src[4] = { 1, 2, 3, 4 };
+    int dest[4] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        SharedRingbuffer<int>::Remove(name.c_str());    // Stale object from an aborted run
+        EXPECT_TRUE(producer.Create(name.c_str(), 4));
+        EXPECT_TRUE(consumer.Attach(name.c_str()));
+    }
+
+    void TearDown() override {
+        SharedRingbuffer<int>::Remove(name.c_str());
+    }
+};
+
+TEST_F(SharedRingbufferTest, CreateAndAttach) {
+    EXPECT_TRUE(producer.IsAttached());
+    EXPECT_TRUE(consumer.IsAttached());
+    EXPECT_TRUE(producer.IsLockFree());
+    EXPECT_EQ(producer.Capacity(), 4);
+    EXPECT_EQ(consumer.Capacity(), 4);              // Read from the shared header
+
+    SharedRingbuffer<int> other;
+    EXPECT_FALSE(other.Create(name.c_str(), 4));    // Exists already
+    EXPECT_FALSE(other.Create(nullptr, 4));
+    EXPECT_FALSE(other.Attach("/RingbufferTest_DoesNotExist"));
+    EXPECT_FALSE(other.IsAttached());
+    EXPECT_FALSE(other.TryPush(pSrc, 1));           // Not attached
+    EXPECT_FALSE(other.TryPop(pDest, 1));
+    EXPECT_EQ(other.Size(), 0);
+}
+
+TEST_F(SharedRingbufferTest, LayoutMismatch) {
+    SharedRingbuffer<uint64_t> otherSize;
+    EXPECT_FALSE(otherSize.Attach(name.c_str()));   // Different element size
+
+    SharedRingbuffer<float> sameSize;
+    EXPECT_TRUE(sameSize.Attach(name.c_str()));     // Layout only, not the type itself
+
+    alignas(64) uint8_t region[512] = { };
+    EXPECT_FALSE(producer.Attach(region, sizeof(region)));  // Not initialized
+    EXPECT_FALSE(producer.Create(region, 8, 4));             // Too small
+    EXPECT_TRUE(producer.Create(region, sizeof(region), 4));
+    EXPECT_TRUE(consumer.Attach(region, sizeof(region)));
+    EXPECT_FALSE(consumer.Attach(region, SharedRingbuffer<int>::RequiredBytes(4) - 1));
+}
+
+TEST_F(SharedRingbufferTest, IndexAlignmentMismatch) {
+    // Shared layout: magic, version, element size, element alignment, capacity,
+    // index alignment and elements offset, then the indices.
+    alignas(64) uint8_t region[512] = { };
+    EXPECT_TRUE(producer.Create(region, sizeof(region), 4));
+    uint64_t* fields = reinterpret_cast<uint64_t*>(region);
+    EXPECT_EQ(fields[4], RINGBUFFER_CACHE_LINE_SIZE);
+
+    fields[4] = 2 * RINGBUFFER_CACHE_LINE_SIZE;     // Creator built with another cache line size
+    EXPECT_FALSE(consumer.Attach(region, sizeof(region)));
+
+    fields[4] = RINGBUFFER_CACHE_LINE_SIZE;
+    fields[5] += RINGBUFFER_CACHE_LINE_SIZE;        // Elements at another offset
+    EXPECT_FALSE(consumer.Attach(region, sizeof(region)));
+
+    fields[5] -= RINGBUFFER_CACHE_LINE_SIZE;
+    EXPECT_TRUE(consumer.Attach(region, sizeof(region)));
+}
+
+TEST_F(SharedRingbufferTest, PushAndPop) {
+    EXPECT_TRUE(producer.TryPush(pSrc, 3));
+    EXPECT_EQ(consumer.Size(), 3);
+    EXPECT_FALSE(producer.TryPush(pSrc, 2));        // Not enough space
+    EXPECT_FALSE(consumer.TryPop(pDest, 4));        // Not enough elements
+
+    EXPECT_TRUE(consumer.TryPop(pDest, 3));
+    EXPECT_EQ(producer.Size(), 0);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+
+    EXPECT_TRUE(producer.TryPush(pSrc, 4));         // Wraps around
+    EXPECT_FALSE(producer.TryPush(pSrc, 1));        // Buffer full
+    EXPECT_TRUE(consumer.TryPop(pDest, 4));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+    EXPECT_FALSE(consumer.TryPop(pDest, 1));        // Buffer empty
+}
+
+TEST_F(SharedRingbufferTest, BetweenProcesses) {
+    const int count = 100000;
+
+    consumer.Detach();
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+
+    if (child == 0) {
+        // Child process: attach by name and produce
+        SharedRingbuffer<int> buffer;
+        if (!buffer.Attach(name.c_str())) {
+            _exit(1);
+        }
+        for (int i = 0; i < count; i++) {
+            while (!buffer.TryPush(&i)) { std::this_thread::yield(); }
+        }
+        _exit(0);
+    }
+
+    producer.Detach();
+    ASSERT_TRUE(consumer.Attach(name.c_str()));
+
+    long long sum = 0;
+    int item = 0;
+    int* pItem = &item;
+    for (int i = 0; i < count; i++) {
+        while (!consumer.TryPop(pItem)) { std::this_thread::yield(); }
+        EXPECT_EQ(item, i);
+        sum += item;
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(sum, static_cast<long long>(count) * (count - 1) / 2);
+}
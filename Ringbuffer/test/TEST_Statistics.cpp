@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+#include <cstddef>      // size_t
+#include <thread>
+
+class RingbufferStatisticsTest : public ::testing::Test {
+protected:
+    Ringbuffer<int, RingbufferStatisticsPolicy> ringBuff;
+    int src[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int dest[8] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(8));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(RingbufferStatisticsTest, InitialState) {
+    const auto statistics = ringBuff.Statistics();
+
+    EXPECT_EQ(statistics.peakSize, 0);
+    EXPECT_EQ(statistics.failedPushes, 0);
+    EXPECT_EQ(statistics.failedPops, 0);
+    for (size_t i = 0; i < RingbufferStatistics::Buckets; i++) {
+        EXPECT_EQ(statistics.pushSizes[i], 0);
+        EXPECT_EQ(statistics.popSizes[i], 0);
+    }
+}
+
+TEST_F(RingbufferStatisticsTest, BlockSizesAndPeak) {
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));                 // Bucket 1
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 1));                 // Bucket 0
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 4));                 // Bucket 2
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 5));                 // Bucket 2
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 3));                 // Bucket 1
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 2));                 // Bucket 1
+    EXPECT_TRUE(ringBuff.TryEmplace(42));                   // Bucket 0
+
+    int item = 0;
+    EXPECT_TRUE(ringBuff.TryPop(item));                     // Bucket 0
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 8), 2);            // Bucket 1
+
+    const auto statistics = ringBuff.Statistics();
+    EXPECT_EQ(statistics.peakSize, 8);
+    EXPECT_EQ(statistics.pushSizes[0], 2);
+    EXPECT_EQ(statistics.pushSizes[1], 2);
+    EXPECT_EQ(statistics.pushSizes[2], 1);
+    EXPECT_EQ(statistics.popSizes[0], 1);
+    EXPECT_EQ(statistics.popSizes[1], 2);
+    EXPECT_EQ(statistics.popSizes[2], 1);
+    EXPECT_EQ(statistics.failedPushes, 0);
+    EXPECT_EQ(statistics.failedPops, 0);
+}
+
+TEST_F(RingbufferStatisticsTest, PeakIsNotOverestimated) {
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 6));
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 6));
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 2));                 // Cached read index is stale, but fits
+
+    EXPECT_EQ(ringBuff.Statistics().peakSize, 6);
+    EXPECT_EQ(ringBuff.Size(), 2);
+}
+
+TEST_F(RingbufferStatisticsTest, FailedPushesAndPops) {
+    int item = 0;
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 1));                // Empty
+    EXPECT_FALSE(ringBuff.TryPop(item));                    // Empty
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 8), 0);            // Empty
+
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 0));                // Invalid size
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 8));
+    EXPECT_FALSE(ringBuff.TryPush(pSrc, 1));                // Full
+    EXPECT_FALSE(ringBuff.TryEmplace(1));                   // Full
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 8), 0);            // Full
+
+    RingbufferSpan<int> first, second;
+    EXPECT_FALSE(ringBuff.TryReserve(1, first, second));    // Full
+
+    const auto statistics = ringBuff.Statistics();
+    EXPECT_EQ(statistics.failedPushes, 5);
+    EXPECT_EQ(statistics.failedPops, 3);
+    EXPECT_EQ(statistics.peakSize, 8);
+}
+
+TEST_F(RingbufferStatisticsTest, ReserveAndPeek) {
+    RingbufferSpan<int> first, second;
+
+    EXPECT_FALSE(ringBuff.TryPeek(1, first, second));       // Empty
+    EXPECT_TRUE(ringBuff.TryReserve(4, first, second));
+    EXPECT_TRUE(ringBuff.Commit(4));                        // Bucket 2
+    EXPECT_TRUE(ringBuff.TryPeek(1, first, second));
+    EXPECT_TRUE(ringBuff.Release(1));                       // Bucket 0
+
+    const auto statistics = ringBuff.Statistics();
+    EXPECT_EQ(statistics.peakSize, 4);
+    EXPECT_EQ(statistics.pushSizes[2], 1);
+    EXPECT_EQ(statistics.popSizes[0], 1);
+    EXPECT_EQ(statistics.failedPops, 1);
+}
+
+TEST_F(RingbufferStatisticsTest, Reset) {
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 4));
+    EXPECT_FALSE(ringBuff.TryPop(pDest, 5));
+
+    ringBuff.Clear();                                       // Statistics are kept
+    EXPECT_EQ(ringBuff.Statistics().peakSize, 4);
+
+    ringBuff.ResetStatistics();
+    EXPECT_EQ(ringBuff.Statistics().peakSize, 0);
+    EXPECT_EQ(ringBuff.Statistics().pushSizes[2], 0);
+    EXPECT_EQ(ringBuff.Statistics().failedPops, 0);
+}
+
+TEST_F(RingbufferStatisticsTest, Threading) {
+    const size_t count = 100000;
+    EXPECT_TRUE(ringBuff.Resize(64));
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < count; i++) {
+            const int value = static_cast<int>(i);
+            while (!ringBuff.TryPush(&value)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t received = 0;
+    size_t failed = 0;
+    while (received < count) {
+        int item = 0;
+        if (ringBuff.TryPop(item)) {
+            EXPECT_EQ(item, static_cast<int>(received));
+            received++;
+        } else {
+            failed++;
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    const auto statistics = ringBuff.Statistics();
+    EXPECT_EQ(statistics.pushSizes[0], count);
+    EXPECT_EQ(statistics.popSizes[0], count);
+    EXPECT_EQ(statistics.failedPops, failed);
+    EXPECT_LE(statistics.peakSize, ringBuff.Capacity());
+    EXPECT_GT(statistics.peakSize, 0);
+}
@@ -4,6 +4,8 @@
 #include <cstdint>      // uint8_t, uint16_t
 #include <thread>
 #include <vector>
+#include <chrono>
+#include <iostream>
 
 class RingbufferTestThreading : public ::testing::TestWithParam<std::tuple<uint8_t, uint8_t>> {
 protected:
@@ -85,3 +87,64 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(4, 4)
     )
 );
+
+
+// Throughput benchmark: single element producer/consumer, compares the packed
+// layout against the cache-line separated (default) layout.
+class RingbufferTestThroughput : public ::testing::Test {
+protected:
+    static const size_t NR_ITEMS_THROUGHPUT = 1000000;
+    static const size_t BUFFER_SIZE         = 1024;
+
+    template<typename Policy>
+    double MeasureThroughput() {
+        Ringbuffer<int, Policy> buffer;
+        EXPECT_TRUE(buffer.Resize(BUFFER_SIZE));
+
+        long long producedSum = 0;
+        long long consumedSum = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread prod([&buffer, &producedSum]() {
+            for (size_t i = 0; i < NR_ITEMS_THROUGHPUT; i++) {
+                const int value = static_cast<int>(i);
+                while (!buffer.TryPush(&value)) { std::this_thread::yield(); }
+                producedSum += value;
+            }
+        });
+        std::thread cons([&buffer, &consumedSum]() {
+            int value = 0;
+            int* pDest = &value;
+            for (size_t i = 0; i < NR_ITEMS_THROUGHPUT; i++) {
+                while (!buffer.TryPop(pDest)) { std::this_thread::yield(); }
+                consumedSum += value;
+            }
+        });
+
+        prod.join();
+        cons.join();
+
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(producedSum, consumedSum);
+        EXPECT_EQ(buffer.Size(), 0);
+
+        return NR_ITEMS_THROUGHPUT / std::chrono::duration<double>(end - start).count();
+    }
+};
+
+TEST_F(RingbufferTestThroughput, PackedVersusPaddedLayout) {
+    EXPECT_GE(sizeof(Ringbuffer<int>), 3 * RINGBUFFER_CACHE_LINE_SIZE);
+
+    const double packed = MeasureThroughput<RingbufferPackedPolicy>();
+    const double padded = MeasureThroughput<RingbufferPolicy>();
+
+#ifndef NDEBUG
+    std::cerr << "Using DEBUG build - results are NOT accurate" << std::endl;
+#endif // NDEBUG
+
+    std::cerr << "Packed layout: " << packed << " items/sec" << std::endl;
+    std::cerr << "Padded layout: " << padded << " items/sec" << std::endl;
+    std::cerr << "Gain:          " << (padded / packed) << "x" << std::endl;
+}
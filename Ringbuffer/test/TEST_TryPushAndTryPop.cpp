@@ -154,3 +154,34 @@ TEST_F(RingbufferTestTryPushAndTryPop, PushAndPopDataDeepInspection) {
 
     ringBuff_ext.Clear();
 }
+
+TEST_F(RingbufferTestTryPushAndTryPop, CachedIndicesAreRefreshed) {
+    int src[3] = { 1, 2, 3 };
+    int dest[3] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    EXPECT_FALSE(ringBuff_ext.TryPop(pDest));           // Empty: consumer caches write index 0
+
+    EXPECT_TRUE(ringBuff_ext.TryPush(pSrc, 3));         // Full: producer still has read index 0 cached
+    EXPECT_FALSE(ringBuff_ext.TryPush(pSrc));
+    EXPECT_TRUE(ringBuff_ext.CheckState(3, 0));
+
+    EXPECT_TRUE(ringBuff_ext.TryPop(pDest, 2));         // Stale write index must be refreshed
+    EXPECT_EQ(dest[0], 1);
+    EXPECT_EQ(dest[1], 2);
+    EXPECT_TRUE(ringBuff_ext.CheckState(3, 2));
+
+    EXPECT_TRUE(ringBuff_ext.TryPush(pSrc, 2));         // Stale read index must be refreshed
+    EXPECT_TRUE(ringBuff_ext.CheckState(1, 2));
+    EXPECT_FALSE(ringBuff_ext.TryPush(pSrc));
+
+    EXPECT_TRUE(ringBuff_ext.TryPop(pDest, 3));
+    EXPECT_EQ(dest[0], 3);
+    EXPECT_EQ(dest[1], 1);
+    EXPECT_EQ(dest[2], 2);
+    EXPECT_FALSE(ringBuff_ext.TryPop(pDest));
+    EXPECT_EQ(ringBuff_ext.Size(), 0);
+
+    ringBuff_ext.Clear();
+}
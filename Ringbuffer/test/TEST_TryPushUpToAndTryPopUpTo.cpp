@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "Ringbuffer.hpp"
+#include <cstddef>      // size_t
+
+class RingbufferUpToTest : public ::testing::Test {
+protected:
+    Ringbuffer<int> ringBuff;
+    int src[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    int dest[8] = { };
+    int* pSrc = &src[0];
+    int* pDest = &dest[0];
+
+    void SetUp() override {
+        EXPECT_TRUE(ringBuff.Resize(5));
+        EXPECT_EQ(ringBuff.Size(), 0);
+    }
+};
+
+TEST_F(RingbufferUpToTest, InvalidArguments) {
+    int* pNull = nullptr;
+
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 0), 0);
+    EXPECT_EQ(ringBuff.TryPushUpTo(nullptr, 1), 0);
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 0), 0);
+    EXPECT_EQ(ringBuff.TryPopUpTo(pNull, 1), 0);
+
+    Ringbuffer<int> empty;                          // No buffer allocated
+    EXPECT_EQ(empty.TryPushUpTo(pSrc, 1), 0);
+    EXPECT_EQ(empty.TryPopUpTo(pDest, 1), 0);
+}
+
+TEST_F(RingbufferUpToTest, PushUpToFreeSpace) {
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 3), 3);
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc + 3, 8), 2); // Only 2 elements free
+    EXPECT_EQ(ringBuff.Size(), 5);
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 1), 0);     // Buffer full
+
+    EXPECT_TRUE(ringBuff.TryPop(pDest, 5));
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+TEST_F(RingbufferUpToTest, PopUpToAvailable) {
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 4), 0);    // Buffer empty
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 8), 3);    // Drains all elements
+    EXPECT_EQ(ringBuff.Size(), 0);
+    EXPECT_TRUE(ringBuff.CheckState(3, 3));
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+
+    EXPECT_TRUE(ringBuff.TryPush(pSrc, 3));
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 2), 2);    // Leaves the remainder
+    EXPECT_EQ(ringBuff.Size(), 1);
+}
+
+TEST_F(RingbufferUpToTest, WrapAround) {
+    ringBuff.SetState(4, 4);                        // Two elements before the end
+
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 8), 5);
+    EXPECT_TRUE(ringBuff.CheckState(3, 4));
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 8), 5);
+    EXPECT_TRUE(ringBuff.CheckState(3, 3));
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}
+
+TEST_F(RingbufferUpToTest, InvalidState) {
+    ringBuff.SetState(6, 0);                        // Write index beyond the buffer
+    EXPECT_EQ(ringBuff.TryPushUpTo(pSrc, 1), 0);
+
+    ringBuff.SetState(0, 6);                        // Read index beyond the buffer
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 1), 0);
+}
+
+TEST(RingbufferUpToTestPowerOfTwo, FreeRunningIndices) {
+    Ringbuffer<int, RingbufferPowerOfTwoPolicy> ringBuff;
+    EXPECT_TRUE(ringBuff.Resize(4));
+
+    int src[6] = { 1, 2, 3, 4, 5, 6 };
+    int dest[6] = { };
+    int* pDest = &dest[0];
+
+    ringBuff.SetState(6, 6);
+    EXPECT_EQ(ringBuff.TryPushUpTo(&src[0], 6), 4);
+    EXPECT_EQ(ringBuff.TryPopUpTo(pDest, 6), 4);
+    EXPECT_TRUE(ringBuff.CheckState(10, 10));
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(dest[i], src[i]);
+    }
+}